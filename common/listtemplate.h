@@ -0,0 +1,258 @@
+// Filename: listtemplate.h
+//
+// Header file for LinkedList<T, Allocator>, the singly linked list under bard's WordList. It constructs any payload
+// T in place, and allocates its nodes through Allocator (std::allocator by default, or a PoolAllocator from
+// nodepool.h). Sorting only relinks nodes, and is logarithmic in depth, so long lists cannot overflow the stack.
+// listwrapper's unrolled int list shares nodepool.h with it, but not this template.
+
+#ifndef LISTTEMPLATE_H
+#define LISTTEMPLATE_H
+
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// node struct to hold data
+template <typename T>
+struct ListNode {
+    T data;
+    ListNode* next;
+};
+
+// Whether allocator A can free all of its nodes at once, through a release() member
+template <typename A, typename = void>
+struct CanRelease : false_type {};
+template <typename A>
+struct CanRelease<A, void_t<decltype(declval<A&>().release())>> : true_type {};
+
+template <typename T, typename Allocator = allocator<T>>
+class LinkedList {
+    public:
+        typedef ListNode<T> Node;
+    private:
+        typedef typename allocator_traits<Allocator>::template rebind_alloc<Node> NodeAllocator;
+        typedef allocator_traits<NodeAllocator> NodeTraits;
+
+        NodeAllocator alloc; // Where Nodes are allocated from
+        Node* head; // Stores head of linked list
+        int size; // Number of Nodes in the list
+
+        template <typename... Args>
+        Node* newNode(Args&&... args); // Allocate a Node, constructing its data from args
+        void freeNode(Node* node); // Destroy the data of a Node removed from the list, and free the Node
+        template <typename Compare>
+        static Node* mergeSort(Node* start, Compare& ranksBefore); // Merge sort the list starting from start
+        template <typename Compare>
+        static Node* mergeLists(Node* left, Node* right, Compare& ranksBefore); // Merge two sorted lists by relinking
+    public:
+        explicit LinkedList(const Allocator& allocator = Allocator()) : alloc(allocator), head(NULL), size(0) {}
+        ~LinkedList() { deleteList(); }
+        LinkedList(LinkedList&& other) noexcept : alloc(other.alloc), head(other.head), size(other.size) { other.head = NULL; other.size = 0; }
+        LinkedList& operator=(LinkedList&& other) noexcept;
+        LinkedList(const LinkedList&) = delete; // Nodes have a single owner
+        LinkedList& operator=(const LinkedList&) = delete;
+
+        template <typename... Args>
+        T& emplace(Args&&... args); // Construct a payload from args in a new Node at the head of the list
+        void deleteList(); // Deletes every Node. A list whose allocator can release its nodes at once does so
+        int length() const { return size; } // Returns the length of the linked list, in constant time
+        Node* getHead() { return head; } // Returns the first Node of the list, to walk the list in order
+
+        template <typename Compare>
+        void sort(Compare ranksBefore); // Stable merge sort, so that no Node is ranked before the Node ahead of it
+        template <typename Compare>
+        void sortTopK(int k, Compare ranksBefore); // Keep only the k first Nodes in sorted order, in that order
+};
+
+// Move assignment frees the Nodes of this list and takes over the Nodes of other
+template <typename T, typename Allocator>
+LinkedList<T, Allocator>& LinkedList<T, Allocator>::operator=(LinkedList&& other) noexcept {
+    if (this != &other) {
+        deleteList();
+        alloc = other.alloc;
+        head = other.head;
+        size = other.size;
+        other.head = NULL;
+        other.size = 0;
+    }
+    return *this;
+}
+
+// Allocate a Node and construct its data in place
+// Input: args, passed on to the constructor of T
+// Output: Pointer to the new Node (its next is not set)
+template <typename T, typename Allocator>
+template <typename... Args>
+typename LinkedList<T, Allocator>::Node* LinkedList<T, Allocator>::newNode(Args&&... args) {
+    Node* node = NodeTraits::allocate(alloc, 1);
+    NodeTraits::construct(alloc, &node->data, std::forward<Args>(args)...);
+    return node;
+}
+
+// Destroy the data of a Node and give the Node back to the allocator
+// Input: Pointer to the Node
+// Output: None
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::freeNode(Node* node) {
+    NodeTraits::destroy(alloc, &node->data);
+    NodeTraits::deallocate(alloc, node, 1);
+}
+
+// Inserts a payload constructed from args into list, at the head of the list
+// Input: args, passed on to the constructor of T
+// Output: Reference to the new payload
+template <typename T, typename Allocator>
+template <typename... Args>
+T& LinkedList<T, Allocator>::emplace(Args&&... args) {
+    Node* to_add = newNode(std::forward<Args>(args)...); // creates new Node
+    to_add->next = head; // make to_add point to existing head
+    head = to_add; // set head to to_add
+    size++;
+    return to_add->data;
+}
+
+// Deletes every Node to prevent memory leaks. When the payload needs no destructor and the allocator can free all
+// of its nodes at once (a PoolAllocator), the list is not walked at all
+// Input: None
+// Output: None
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::deleteList() {
+    if constexpr (CanRelease<NodeAllocator>::value && is_trivially_destructible<T>::value) {
+        if (head != NULL) // release the pool in one shot
+            alloc.release();
+    } else {
+        Node* curr = head;
+        while (curr != NULL) { // loop over list, storing the next Node before deleting the current one
+            Node* temp = curr->next;
+            freeNode(curr);
+            curr = temp;
+        }
+    }
+    head = NULL;
+    size = 0;
+}
+
+// Sorts the list by relinking its Nodes with a merge sort; no payload is copied or moved.
+// Input: ranksBefore, a function from (const T&, const T&) to bool, true if the first must come before the second
+// Output: None
+template <typename T, typename Allocator>
+template <typename Compare>
+void LinkedList<T, Allocator>::sort(Compare ranksBefore) {
+    head = mergeSort(head, ranksBefore);
+}
+
+// Recursively merge sort the list starting from start. The recursion depth is the log of the length
+// Input: start, the first Node of the list to sort. ranksBefore, the order
+// Output: The head Node of the sorted list
+template <typename T, typename Allocator>
+template <typename Compare>
+typename LinkedList<T, Allocator>::Node* LinkedList<T, Allocator>::mergeSort(Node* start, Compare& ranksBefore) {
+    if (start == NULL || start->next == NULL) { // base case: the list is empty or has one Node, so it is sorted
+        return start;
+    }
+
+    // Find the middle of the list. fast moves two Nodes for every Node slow moves, so when fast reaches the
+    // end of the list, slow is at the last Node of the first half
+    Node* slow = start;
+    Node* fast = start->next;
+    while (fast != NULL && fast->next != NULL) {
+        slow = slow->next;
+        fast = fast->next->next;
+    }
+
+    Node* secondHalf = slow->next; // the second half starts after slow
+    slow->next = NULL; // detach the first half from the second half
+
+    Node* left = mergeSort(start, ranksBefore);
+    Node* right = mergeSort(secondHalf, ranksBefore);
+    return mergeLists(left, right, ranksBefore); // sort both halves and merge them together
+}
+
+// Merge two sorted lists into one sorted list by relinking their Nodes
+// Input: left and right, the heads of two sorted lists. ranksBefore, the order
+// Output: The head Node of the merged list
+template <typename T, typename Allocator>
+template <typename Compare>
+typename LinkedList<T, Allocator>::Node* LinkedList<T, Allocator>::mergeLists(Node* left, Node* right, Compare& ranksBefore) {
+    Node* mergedHead = NULL; // head of the merged list
+    Node** tail = &mergedHead; // where the next Node of the merged list is linked
+
+    while (left != NULL && right != NULL) { // loop until one of the lists runs out
+        // left goes first unless right is ranked strictly before it. Taking left on ties keeps the sort stable
+        if (!ranksBefore(right->data, left->data)) {
+            *tail = left;
+            left = left->next;
+        } else {
+            *tail = right;
+            right = right->next;
+        }
+        tail = &(*tail)->next;
+    }
+    *tail = (left != NULL) ? left : right; // append whatever is left over, it is already sorted
+
+    return mergedHead;
+}
+
+// Keep only the k first Nodes in sorted order, in the order sort() would put them, and delete the rest.
+// A bounded heap holds the best k Nodes seen so far, so this is O(n log k) instead of sorting the whole list
+// Input: k, the number of Nodes to keep. ranksBefore, the order
+// Output: None
+template <typename T, typename Allocator>
+template <typename Compare>
+void LinkedList<T, Allocator>::sortTopK(int k, Compare ranksBefore) {
+    // The heap keeps its worst ranked Node on top, so that it is the one replaced by a better Node. Ties are broken by
+    // position in the list, the way the stable sort() breaks them
+    vector<pair<Node*, int>> best;
+    best.reserve(k > 0 ? min(k, size) : 0);
+    auto worseRanked = [&](const pair<Node*, int>& left, const pair<Node*, int>& right) {
+        if (ranksBefore(left.first->data, right.first->data)) return true;
+        if (ranksBefore(right.first->data, left.first->data)) return false;
+        return left.second < right.second;
+    };
+    int position = 0;
+    for (Node* curr = head; curr != NULL; curr = curr->next, position++) { // loop through the list
+        pair<Node*, int> entry(curr, position);
+        if ((int) best.size() < k) { // the heap is not full yet
+            best.push_back(entry);
+            push_heap(best.begin(), best.end(), worseRanked);
+        } else if (k > 0 && worseRanked(entry, best.front())) { // curr beats the worst of the best k
+            pop_heap(best.begin(), best.end(), worseRanked);
+            best.back() = entry;
+            push_heap(best.begin(), best.end(), worseRanked);
+        }
+    }
+    sort_heap(best.begin(), best.end(), worseRanked); // puts the best k Nodes in rank order
+
+    // Free the Nodes that did not make it. A pool that is released at once frees them along with the rest
+    if constexpr (!(CanRelease<NodeAllocator>::value && is_trivially_destructible<T>::value)) {
+        vector<int> keptPositions; // positions of the kept Nodes, in list order
+        keptPositions.reserve(best.size());
+        for (size_t i = 0; i < best.size(); i++)
+            keptPositions.push_back(best[i].second);
+        std::sort(keptPositions.begin(), keptPositions.end());
+        size_t nextKept = 0;
+        position = 0;
+        for (Node* curr = head; curr != NULL; position++) { // loop through the list
+            Node* next = curr->next;
+            if (nextKept < keptPositions.size() && keptPositions[nextKept] == position)
+                nextKept++;
+            else
+                freeNode(curr);
+            curr = next;
+        }
+    }
+
+    // Relink the best k Nodes in rank order
+    head = NULL;
+    for (int i = (int) best.size() - 1; i >= 0; i--) { // link from the back, so each Node points at the next one
+        best[i].first->next = head;
+        head = best[i].first;
+    }
+    size = best.size();
+}
+
+#endif
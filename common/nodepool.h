@@ -0,0 +1,109 @@
+// Filename: nodepool.h
+//
+// Header file for the node allocator shared by the linked lists of bard and listwrapper. A NodePool carves
+// fixed-size nodes out of large chunks, recycles the nodes given back to it, and frees every chunk at once.
+// PoolAllocator is a standard allocator on top of a NodePool, so a LinkedList<T, PoolAllocator<T>> (see
+// listtemplate.h) allocates all of its nodes from one pool.
+
+#ifndef NODEPOOL_H
+#define NODEPOOL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <vector>
+
+using namespace std;
+
+// Smallest and largest number of nodes in a chunk. Chunks start small so that short lists stay small,
+// and double in size as the list grows
+const int MIN_CHUNK_SIZE = 64;
+const int MAX_CHUNK_SIZE = 8192;
+
+// Allocates nodes of one size by carving them out of large chunks. A pool belongs to a single list, so that
+// releasing the pool frees exactly that list
+class NodePool {
+    private:
+        vector<char*> chunks; // Every chunk allocated so far
+        size_t nodeSize; // Size of every node, fixed by the first allocation (0 before that)
+        int chunkSize; // Number of nodes in the newest chunk
+        int used; // Number of nodes handed out from the newest chunk
+        void* freeList; // Nodes given back to the pool, each holding a pointer to the next one
+    public:
+        NodePool() : nodeSize(0), chunkSize(0), used(0), freeList(NULL) {} // No chunk is allocated until the first node is needed
+        ~NodePool() { release(); } // Frees every chunk
+        NodePool(const NodePool&) = delete; // Chunks have a single owner
+        NodePool& operator=(const NodePool&) = delete;
+
+        void* allocate(size_t size); // Returns storage for one node of size bytes
+        void deallocate(void* node); // Gives a node back to the pool, to be handed out again
+        void release(); // Frees every node handed out by the pool in one shot
+};
+
+// Returns storage for one node: a node given back earlier if there is one, otherwise the next unused node of the
+// newest chunk. When the chunk is full, a new chunk twice its size is allocated
+// Input: size, the size of the node (the same for every call)
+// Output: Pointer to the storage of the node
+inline void* NodePool::allocate(size_t size) {
+    if (freeList != NULL) { // reuse a node that was given back
+        void* node = freeList;
+        freeList = *static_cast<void**>(node);
+        return node;
+    }
+    if (nodeSize == 0) { // first node: every node is this big, and big enough to hold the free list pointer
+        nodeSize = max(size, sizeof(void*));
+    }
+    if (used == chunkSize) { // the newest chunk is full (or there are no chunks yet)
+        chunkSize = min(max(2 * chunkSize, MIN_CHUNK_SIZE), MAX_CHUNK_SIZE); // grow the chunk size
+        chunks.push_back(static_cast<char*>(::operator new(nodeSize * chunkSize))); // allocate the new chunk
+        used = 0;
+    }
+    return chunks.back() + nodeSize * used++; // hand out the next unused node of the chunk
+}
+
+// Gives a node back to the pool. It is put on the free list and handed out by the next allocate
+// Input: node, storage returned by allocate
+// Output: None
+inline void NodePool::deallocate(void* node) {
+    *static_cast<void**>(node) = freeList;
+    freeList = node;
+}
+
+// Frees every node that was handed out by the pool
+// Input: None
+// Output: None
+inline void NodePool::release() {
+    for (size_t i = 0; i < chunks.size(); i++) { // loop over the chunks
+        ::operator delete(chunks[i]); // free the whole chunk at once
+    }
+    chunks.clear();
+    chunkSize = 0;
+    used = 0;
+    freeList = NULL;
+}
+
+// A standard allocator that takes one node at a time from a NodePool. Copies (and rebound copies, for the node
+// type of a list) share the pool
+template <typename T>
+class PoolAllocator {
+    private:
+        NodePool* pool;
+        template <typename U> friend class PoolAllocator;
+    public:
+        typedef T value_type;
+
+        explicit PoolAllocator(NodePool* nodePool) : pool(nodePool) {}
+        template <typename U>
+        PoolAllocator(const PoolAllocator<U>& other) : pool(other.pool) {}
+
+        T* allocate(size_t n) { return n == 1 ? static_cast<T*>(pool->allocate(sizeof(T))) : static_cast<T*>(::operator new(n * sizeof(T))); }
+        void deallocate(T* p, size_t n) { if (n == 1) pool->deallocate(p); else ::operator delete(p); }
+        void release() { pool->release(); } // Free every node of the pool at once (see LinkedList::deleteList)
+
+        template <typename U>
+        bool operator==(const PoolAllocator<U>& other) const { return pool == other.pool; }
+        template <typename U>
+        bool operator!=(const PoolAllocator<U>& other) const { return pool != other.pool; }
+};
+
+#endif
@@ -0,0 +1,155 @@
+// Filename: scanner.h
+//
+// Header file for the scanner shared by the drivers (bard, wordrange, sixdegrees, listwrapper) to split their
+// input files into lines and whitespace separated tokens. Newlines are found with memchr, which the C library
+// already vectorizes for the machine it runs on. Whitespace, which is a set of bytes that memchr cannot look for,
+// is found 16 bytes at a time with SSE2, with a plain loop for other machines and for the last few bytes of the
+// text. Lines and tokens are string_views into the text, so nothing is copied.
+
+#ifndef SCANNER_H
+#define SCANNER_H
+
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+// Whether c is whitespace: ' ', '\t', '\n', '\v', '\f' or '\r'
+inline bool isSpaceChar(char c) {
+    return c == ' ' || (unsigned char) (c - '\t') <= (unsigned char) ('\r' - '\t');
+}
+
+#if defined(__SSE2__)
+// Bit i of the result is set if byte i of the 16 bytes at p is whitespace
+inline unsigned int matchSpace16(const char* p) {
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i isBlank = _mm_cmpeq_epi8(bytes, _mm_set1_epi8(' '));
+    // '\t' through '\r' are the bytes b with (b - '\t') <= 4 as unsigned bytes, that is min(b - '\t', 4) == b - '\t'
+    __m128i shifted = _mm_sub_epi8(bytes, _mm_set1_epi8('\t'));
+    __m128i isControl = _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8('\r' - '\t')), shifted);
+    return (unsigned int) _mm_movemask_epi8(_mm_or_si128(isBlank, isControl));
+}
+#endif
+
+// Find the first byte equal to c from begin up to end
+// Input: begin and end, the text. c, the byte to look for
+// Output: Pointer to the first c, or end if there is none
+inline const char* findByte(const char* begin, const char* end, char c) {
+    const void* found = memchr(begin, c, end - begin);
+    return (found != NULL) ? static_cast<const char*>(found) : end;
+}
+
+// Find the first whitespace byte (or, if wantSpace is false, the first byte that is not whitespace) from begin up to end
+// Input: begin and end, the text. wantSpace, which kind of byte to look for
+// Output: Pointer to the byte, or end if there is none
+inline const char* findSpaceOrNot(const char* begin, const char* end, bool wantSpace) {
+    const char* curr = begin;
+    // Runs of whitespace (and short tokens) are usually only a few bytes long, so check those one at a time first
+    for (const char* shortEnd = (end - curr > 4) ? curr + 4 : end; curr < shortEnd; curr++) {
+        if (isSpaceChar(*curr) == wantSpace) {
+            return curr;
+        }
+    }
+    unsigned int flip = wantSpace ? 0 : ~0u; // flipping the mask turns "is whitespace" into "is not whitespace"
+#if defined(__SSE2__)
+    for (; end - curr >= 16; curr += 16) {
+        unsigned int mask = (matchSpace16(curr) ^ flip) & 0xFFFF;
+        if (mask != 0) {
+            return curr + __builtin_ctz(mask);
+        }
+    }
+#endif
+    while (curr < end && isSpaceChar(*curr) != wantSpace) { // the last few bytes (or every byte, without SSE2)
+        curr++;
+    }
+    return curr;
+}
+
+// Find the first whitespace byte from begin up to end, or end if there is none
+inline const char* findSpace(const char* begin, const char* end) {
+    return findSpaceOrNot(begin, end, true);
+}
+
+// Skip the whitespace at begin, and return the first byte that is not whitespace (or end)
+inline const char* skipSpace(const char* begin, const char* end) {
+    return findSpaceOrNot(begin, end, false);
+}
+
+// Splits text into lines, the same way getline does: on '\n', with a final line that has no '\n' still counted
+class LineScanner {
+    private:
+        const char* curr; // Start of the next line
+        const char* end; // End of the text
+    public:
+        LineScanner(const char* text, size_t size) : curr(text), end(text + size) {}
+        LineScanner(string_view text) : curr(text.data()), end(text.data() + text.size()) {}
+
+        // Set line to the next line (without its '\n'). Returns false once there are no lines left
+        bool next(string_view& line) {
+            if (curr >= end) {
+                return false;
+            }
+            const char* lineEnd = findByte(curr, end, '\n');
+            line = string_view(curr, lineEnd - curr);
+            curr = lineEnd + 1; // move past the '\n' (past end for a final line without one)
+            return true;
+        }
+};
+
+// Splits text into tokens separated by any amount of whitespace, the same way operator>> reads strings
+class TokenScanner {
+    private:
+        const char* curr; // Where to look for the next token
+        const char* end; // End of the text
+    public:
+        TokenScanner(const char* text, size_t size) : curr(text), end(text + size) {}
+        TokenScanner(string_view text) : curr(text.data()), end(text.data() + text.size()) {}
+
+        // Set token to the next token. Returns false once there are no tokens left
+        bool next(string_view& token) {
+            curr = skipSpace(curr, end);
+            if (curr >= end) {
+                return false;
+            }
+            const char* tokenEnd = findSpace(curr, end);
+            token = string_view(curr, tokenEnd - curr);
+            curr = tokenEnd;
+            return true;
+        }
+
+        // Whether there is anything other than whitespace left
+        bool empty() {
+            curr = skipSpace(curr, end);
+            return curr >= end;
+        }
+};
+
+// Read the whole file into contents, so that it can be scanned in place
+// Input: filename, the file to read. contents, set to the bytes of the file
+// Output: Bool, whether the file could be read
+inline bool readFile(const string& filename, string& contents) {
+    ifstream file(filename, ios::binary);
+    if (!file) {
+        return false;
+    }
+    file.seekg(0, ios::end);
+    streamoff fileSize = file.tellg();
+    file.seekg(0, ios::beg);
+    if (fileSize < 0) { // not a regular file, so the size is not known up front
+        contents.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+        return true;
+    }
+    contents.resize(fileSize);
+    file.read(&contents[0], fileSize);
+    return !file.bad();
+}
+
+#endif
@@ -0,0 +1,112 @@
+// Filename: trace.h
+//
+// Header file for the console tracing shared by the drivers (listwrapper, nqueens, wordrange). A trace line is
+// written with TRACE(level, pieces...) and only appears if level is at most the current trace level. A piece is
+// text, a character, an integer, or an object with a print(Writer&) member such as a LinkedList. Lines go
+// through a Writer on cout, so tracing does not flush the console once per line; traceFlush() hands everything
+// to cout, and so does exiting the program. The level starts at TRACE_INFO, or at the level named by the TRACE_LEVEL
+// environment variable ("off", "info" or "debug", or 0, 1 or 2), so "TRACE_LEVEL=debug ./nqueens in out" turns on the
+// debug lines of a driver without changing its arguments. Compiling with -DNTRACE removes every TRACE line from the
+// program, arguments included, the same way -DNDEBUG removes asserts.
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <cstdlib>
+#include <iostream>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "writer.h"
+
+using namespace std;
+
+// How much the drivers write to the console. A line is traced if its level is at most the current level
+enum TraceLevel { TRACE_OFF = 0, TRACE_INFO = 1, TRACE_DEBUG = 2 };
+
+#ifndef NTRACE
+
+// The trace level named by the TRACE_LEVEL environment variable, or TRACE_INFO if it is not set or not a level
+inline TraceLevel traceLevelFromEnv() {
+    const char* value = getenv("TRACE_LEVEL");
+    string_view name = (value != NULL) ? value : "";
+    if (name == "off" || name == "0") {
+        return TRACE_OFF;
+    }
+    if (name == "debug" || name == "2") {
+        return TRACE_DEBUG;
+    }
+    return TRACE_INFO;
+}
+
+// The console trace: a Writer on cout and the current trace level (from TRACE_LEVEL unless it is changed)
+class Tracer {
+    private:
+        Writer writer; // Trace lines that have not been handed to cout yet
+        TraceLevel level; // Lines above this level are skipped
+    public:
+        Tracer() : writer(cout), level(traceLevelFromEnv()) {}
+
+        bool enabled(TraceLevel lineLevel) const { return lineLevel != TRACE_OFF && lineLevel <= level; }
+        void setLevel(TraceLevel newLevel) { level = newLevel; }
+        Writer& out() { return writer; } // Where the pieces of a trace line are written
+
+        // Append one piece of a trace line: text, a single character, an integer, or an object that prints itself
+        void put(string_view text) { writer.write(text); }
+        void put(char c) { writer.write(c); }
+        template <typename T, typename = enable_if_t<is_integral<T>::value>>
+        void put(T value) { writer.writeInt(value); }
+        template <typename T>
+        auto put(T& object) -> decltype(object.print(declval<Writer&>()), void()) { object.print(writer); }
+
+        // Append every piece, without ending the line
+        template <typename... Pieces>
+        void part(Pieces&&... pieces) {
+            (put(forward<Pieces>(pieces)), ...);
+        }
+
+        // Append every piece, then end the line
+        template <typename... Pieces>
+        void line(Pieces&&... pieces) {
+            part(forward<Pieces>(pieces)...);
+            writer.write('\n');
+        }
+};
+
+// The one Tracer of the program. It is destroyed at exit, which flushes whatever is left
+inline Tracer& tracer() {
+    static Tracer instance;
+    return instance;
+}
+
+// Set the trace level of the program
+inline void setTraceLevel(TraceLevel level) {
+    tracer().setLevel(level);
+}
+
+// Hand every trace line written so far to cout (cout itself is not flushed)
+inline void traceFlush() {
+    tracer().out().flush();
+}
+
+// Write a trace line made of pieces, if level is enabled. The pieces are not evaluated otherwise
+#define TRACE(level, ...) do { if (tracer().enabled(level)) tracer().line(__VA_ARGS__); } while (0)
+
+// Write pieces without ending the line, if level is enabled, for trace lines that are built in a loop
+#define TRACE_PART(level, ...) do { if (tracer().enabled(level)) tracer().part(__VA_ARGS__); } while (0)
+
+// Whether a trace line at level would be written, so a loop that only builds trace lines can be skipped
+#define TRACE_ENABLED(level) (tracer().enabled(level))
+
+#else // NTRACE: tracing is compiled out
+
+inline void setTraceLevel(TraceLevel) {}
+inline void traceFlush() {}
+
+#define TRACE(level, ...) do { } while (0)
+#define TRACE_PART(level, ...) do { } while (0)
+#define TRACE_ENABLED(level) (false)
+
+#endif
+
+#endif
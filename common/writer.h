@@ -0,0 +1,91 @@
+// Filename: writer.h
+//
+// Header file for the buffered writer shared by the drivers (bard, listwrapper) to write their output. Text and
+// integers are collected in a fixed buffer and handed to the stream in large blocks. Integers are formatted in
+// place with to_chars, so nothing is allocated while writing. The writer never flushes the stream itself.
+
+#ifndef WRITER_H
+#define WRITER_H
+
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string_view>
+
+using namespace std;
+
+const size_t WRITER_BUFFER_SIZE = 1 << 16; // bytes collected before they are written to the stream
+
+class Writer {
+    private:
+        ostream& out; // Where the text is written
+        char buffer[WRITER_BUFFER_SIZE]; // Text that has not been written yet
+        size_t used; // Number of bytes of buffer in use
+    public:
+        explicit Writer(ostream& stream) : out(stream), used(0) {} // Constructor for a writer that writes to stream
+        ~Writer() { flush(); } // Writes any text that is left
+        Writer(const Writer&) = delete; // The buffer has a single owner
+        Writer& operator=(const Writer&) = delete;
+
+        void write(string_view text); // Append text
+        void write(char c); // Append a single character
+        void writeInt(long long value); // Append value in decimal
+        void writeLine(string_view line); // Append line and a newline
+        void flush(); // Write every buffered byte to the stream
+};
+
+// Append text to the buffer. Text longer than the whole buffer is written to the stream directly
+// Input: text, the characters to append
+// Output: None
+inline void Writer::write(string_view text) {
+    if (text.size() > WRITER_BUFFER_SIZE - used) { // text does not fit in what is left of the buffer
+        flush();
+        if (text.size() >= WRITER_BUFFER_SIZE) {
+            out.write(text.data(), text.size());
+            return;
+        }
+    }
+    memcpy(buffer + used, text.data(), text.size());
+    used += text.size();
+}
+
+// Append a single character to the buffer
+// Input: c, the character to append
+// Output: None
+inline void Writer::write(char c) {
+    if (used == WRITER_BUFFER_SIZE) {
+        flush();
+    }
+    buffer[used++] = c;
+}
+
+// Append an integer in decimal, formatted straight into the buffer
+// Input: value, the integer to append
+// Output: None
+inline void Writer::writeInt(long long value) {
+    if (WRITER_BUFFER_SIZE - used < 20) { // the longest long long, "-9223372036854775808", is 20 characters
+        flush();
+    }
+    used = to_chars(buffer + used, buffer + WRITER_BUFFER_SIZE, value).ptr - buffer;
+}
+
+// Append a line and a newline to the buffer
+// Input: line, the text of the line (without a newline)
+// Output: None
+inline void Writer::writeLine(string_view line) {
+    write(line);
+    write('\n');
+}
+
+// Write every buffered byte to the stream in one call
+// Input: None
+// Output: None
+inline void Writer::flush() {
+    if (used > 0) {
+        out.write(buffer, used);
+        used = 0;
+    }
+}
+
+#endif
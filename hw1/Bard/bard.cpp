@@ -4,12 +4,29 @@
 //
 // After running make, the usage is:
 //    ./bard <INPUT_FILE> <OUTPUT_FILE>
+//
+// To rank the corpus once and reuse the rankings across many runs:
+//    ./bard --build-index <INDEX_FILE>
+//    ./bard --index <INDEX_FILE> <INPUT_FILE> <OUTPUT_FILE>
+//
+// The corpus is read from shakespeare-cleaned5.txt, or from every file and directory given with --corpus <PATH>.
+// It is counted and ranked with one worker thread per core, or with N worker threads given --threads <N>.
+// Given --top-k, only the top of each list is ranked, up to the highest rank the input file asks for
+//
+// To keep ranking text as it streams in on standard input (lines of "? LENGTH RANK" are queries):
+//    ./bard --incremental <OUTPUT_FILE>
+//
+// Given --stats (or --stats-file <FILE>), the wall time and heap allocations of every phase, the biggest word lists
+// and the peak memory use are written as JSON to standard error (or to FILE) at the end of the run
 // 
 // Input (from the assignment specs): "The input file contains a new query. The query is a pair of numbers: LENGTH RANK. 
 // The first number is the length of the word, the second number is the rank, which starts from 0. The ranking is done 
 // in decreasing order of frequence, and increasing lexicographic order."
+// A line can also hold a range query, LENGTH RANK_START COUNT, which asks for COUNT words ranked from RANK_START on,
+// or a prefix query, PREFIX RANK or PREFIX LENGTH RANK, which ranks only the words that start with PREFIX
 //
 // Output (from the assignment specs): "The output for each line is the corresponding word. If no word exists, the output is '-'."
+// The answer to a range query is the words of the range on one line, separated by spaces ('-' if there are none)
 //
 // Look at the associated pdf (hw_shakespeare.pdf) in this directory for more details.
 //
@@ -17,88 +34,415 @@
 
 #include <iostream>
 #include "linkedlist.h"
+#include "corpus.h"
+#include "wordpool.h"
+#include "rankindex.h"
+#include "prefixindex.h"
+#include "parallel.h"
+#include "queries.h"
+#include "rankedset.h"
+#include "stats.h"
+#include "writer.h"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <memory>
 #include <sstream>
+#include <stdexcept>
+#include <vector>
 using namespace std;
 
-int main(int argc, char** argv) {
-    if (argc < 3) {// must provide two arguments as input
-      throw std::invalid_argument("Usage: ./hello <INPUT FILE> <OUTPUT FILE>"); // throw error
+// Read the corpus files and build one LinkedList per word length, holding every unique word of that length with its frequency
+// Input: corpusFiles, the text to read (one word per line). numThreads, the number of worker threads to count with.
+// wordPool, where the characters of the words are kept. nodePools and wordsList, filled with one NodePool and one
+// LinkedList per word length
+// Output: None
+void loadWordsLists(const vector<string>& corpusFiles, int numThreads, WordPool& wordPool, vector<NodePool>& nodePools,
+                    vector<WordList>& wordsList) {
+    // Map the full text of all compositions of Shakespeare into memory and read it in a single pass,
+    // counting the occurrences of every word with a hash table (word -> frequency) per word length.
+    // The buckets grow as longer words are found, so there is no need to find the longest word first.
+    // Every file (or slice of a large file) is counted by one of the worker threads, and their counts are merged
+    vector<unique_ptr<Corpus>> shakespeareText; // the mapped corpus files
+    vector<WordCounts> wordFrequencies; // wordFrequencies[n] counts the words of length n
+    countCorpusFiles(corpusFiles, numThreads, shakespeareText, wordFrequencies);
+
+    // initailize an array of LinkedLists to hold words that are at most maxWordLength characters long.
+    // Every WordList allocates its Nodes from its own NodePool, which frees the whole list at once
+    int maxWordLength = (int) wordFrequencies.size() - 1; // store the length of the longest word in the text file
+    nodePools = vector<NodePool>(maxWordLength + 1);
+    wordsList.clear();
+    wordsList.reserve(maxWordLength + 1);
+    for (int i = 0; i <= maxWordLength; i++) {
+        wordsList.push_back(WordList(&nodePools[i]));
     }
-    string word = ""; // will store the word in the input file
-    int maxWordLength = 0; // store the length of the longest word in the text file
-    
-    ifstream input; // stream for input file
-    ofstream output; // stream for output file
-	
-    ifstream shakespeareText("shakespeare-cleaned5.txt"); // open the full text of all compositions of Shakespeare
-    // Iterate shakespeareText to find the longest word in the file
-    while (getline(shakespeareText, word)) {
-        int wordLen = word.length(); // store the length of the current word
-        if (wordLen > maxWordLength) { // if we have found a word with a longer length than the previous maxWordLength
-            maxWordLength = wordLen; // update the max word length
+
+    // Every unique word is copied once into wordPool, and the Nodes point at that copy. That way the mapped
+    // text can be closed, and only the vocabulary stays in memory
+    size_t vocabularySize = 0; // total number of characters over all unique words
+    for (int i = 0; i <= maxWordLength; i++) {
+        vocabularySize += (size_t) i * wordFrequencies[i].size();
+    }
+    wordPool.reserve(vocabularySize); // keep the whole vocabulary in one contiguous block
+
+    // Each LinkedList in wordList at array index n stores all unique words of length n
+    for (int i = 0; i <= maxWordLength; i++) {
+        for (WordCounts::iterator freqIter = wordFrequencies[i].begin(); freqIter != wordFrequencies[i].end(); ++freqIter) {
+            // insert the interned word with its frequency into its LinkedList
+            wordsList[i].insert(wordPool.intern(freqIter->first), freqIter->second);
         }
     }
-    shakespeareText.close(); // close the input text file
-    
+    wordFrequencies.clear(); // the counts point into the mapped text, so drop them before closing it
+    shakespeareText.clear(); // close the input text files
+}
+
+// Rank every LinkedList, so that each is in decreasing order of frequency and increasing lexicographic order.
+// The lists are independent of each other, so they are ranked in parallel, biggest list first
+// Input: wordsList, the lists of unique words for every word length. numThreads, the number of worker threads.
+// rankLimits, if not empty, the number of ranks to keep for every word length (only that prefix of each list is ranked)
+// Output: None
+void rankWordsLists(vector<WordList>& wordsList, int numThreads, const vector<int>& rankLimits) {
+    int wordsListSize = wordsList.size(); // store the length of the wordsList array
+
+    // Order the lists from longest to shortest, so that the biggest lists (the 4 to 7 letter words) start first
+    // and the small ones fill in around them
+    vector<int> listLengths(wordsListSize);
+    vector<int> rankOrder(wordsListSize);
+    for(int i = 0; i < wordsListSize; i++) {
+        listLengths[i] = wordsList[i].length();
+        rankOrder[i] = i;
+    }
+    stable_sort(rankOrder.begin(), rankOrder.end(), [&](int left, int right) {
+        return listLengths[left] > listLengths[right];
+    });
+
     /*
-     * With the longest length of all the words in the text file, we can create our array of LinkedLists
+     * With all of the unique words in their respective linked list, we have to go through each linked list and
+     * sort the list (in decreasing order of frequency and increasing lexicographic order).
+     * Every list has its own NodePool, so no two workers ever touch the same memory
      */
-    // initailize an array of LinkedLists to hold words that are at most maxWordLength characters long
-    LinkedList wordsList[maxWordLength + 1]; 
+    runTasks(rankOrder, [&](int i) {
+        if (rankLimits.empty()) { // rank the whole list
+            wordsList[i].sortLists();
+        } else { // only the top of the list is ever queried
+            wordsList[i].sortTopK(rankLimits[i]);
+        }
+    }, numThreads);
+}
+
+// Rank the corpus, then keep the rankings up to date as more text streams in on standard input. Every line of
+// standard input is either a query "? LENGTH RANK", answered right away, or a word to count (one word per line,
+// like the corpus). Works with a growing file through "tail -f <FILE> | ./bard --incremental <OUTPUT FILE>"
+// Input: corpusFiles, the text to start from. numThreads, the number of worker threads to count the corpus with.
+// outputFile, where the answers go ("-" for standard output). stats, where the phases of the run are recorded
+// Output: None
+void runIncremental(const vector<string>& corpusFiles, int numThreads, const string& outputFile, RunStats& stats) {
+    IncrementalRanker ranker; // one order statistic tree per word length
+
+    stats.startPhase("load");
+    // Start from the counts of the corpus, so each unique word is inserted once
+    vector<unique_ptr<Corpus>> shakespeareText; // the mapped corpus files
+    vector<WordCounts> wordFrequencies; // wordFrequencies[n] counts the words of length n
+    countCorpusFiles(corpusFiles, numThreads, shakespeareText, wordFrequencies);
+    for (size_t i = 0; i < wordFrequencies.size(); i++) {
+        for (WordCounts::iterator freqIter = wordFrequencies[i].begin(); freqIter != wordFrequencies[i].end(); ++freqIter) {
+            ranker.addWord(freqIter->first, freqIter->second); // the ranker keeps its own copy of the word
+        }
+    }
+    wordFrequencies.clear(); // the counts point into the mapped text, so drop them before closing it
+    shakespeareText.clear();
+    vector<int> bucketSizes;
+    for (int i = 0; i <= ranker.maxWordLength(); i++) {
+        bucketSizes.push_back(ranker.size(i));
+    }
+    stats.setBucketSizes(bucketSizes);
 
-    shakespeareText.open("shakespeare-cleaned5.txt"); // reopen the input text file
-    // Each LinkedList in wordList at array index n stores all words of length n
-    while (getline(shakespeareText, word)) { // loop through shakespeareText
-          int wordLen = word.length(); // get the length of the current word
-          wordsList[wordLen].insert(word); // insert the word into its corresponding LinkedList (including duplicates)
+    stats.startPhase("stream"); // everything read from standard input until it is closed
+    ofstream outputStream;
+    if (outputFile != "-") {
+        outputStream.open(outputFile);
     }
-	
-    int wordsListSize = sizeof(wordsList)/sizeof(wordsList[0]); // store the length of the wordsList array
+    ostream& output = (outputFile == "-") ? cout : outputStream;
+
+    ios::sync_with_stdio(false); // standard input is only read through cin
+    string line = "";
+    while (getline(cin, line)) { // loop through standard input as it arrives
+        if (!line.empty() && line[0] == '?') { // a query
+            const char* curr = line.data() + 1;
+            const char* end = line.data() + line.size();
+            int length = 0, rank = 0;
+            string_view answer = "-";
+            if (parseInt(curr, end, length) && parseInt(curr, end, rank)) {
+                answer = ranker.findRank(length, rank);
+            }
+            output << answer << "\n";
+            output.flush(); // whoever is following the output should see the answer now
+        } else { // one more occurence of a word
+            ranker.addWord(line);
+        }
+    }
+}
+
+// Record the number of unique words in every LinkedList, before any of them is cut short by --top-k
+// Input: stats, where to record them. wordsList, the lists of unique words for every word length
+// Output: None
+void recordBucketSizes(RunStats& stats, vector<WordList>& wordsList) {
+    vector<int> bucketSizes;
+    for (size_t i = 0; i < wordsList.size(); i++) {
+        bucketSizes.push_back(wordsList[i].length());
+    }
+    stats.setBucketSizes(bucketSizes);
+}
+
+// End the last phase and write the stats, if they were asked for
+// Input: stats, the phases of the run. statsFile, where to write them ("-" for standard error, "" to not write them)
+// Output: None
+void reportStats(RunStats& stats, const string& statsFile) {
+    stats.endPhase();
+    if (statsFile.empty()) {
+        return;
+    }
+    if (statsFile == "-") {
+        stats.write(cerr);
+        return;
+    }
+    ofstream statsStream(statsFile);
+    if (!statsStream) {
+        throw std::runtime_error("Could not write " + statsFile); // throw error
+    }
+    stats.write(statsStream);
+}
+
+int main(int argc, char** argv) {
+    vector<string> corpusFiles; // the text to rank, given by --corpus (by default, shakespeare-cleaned5.txt)
+    int numThreads = defaultThreadCount(); // number of worker threads to rank the lists with
+    string indexFile = ""; // the index file to answer queries from, if one was given
+    string buildIndexFile = ""; // the index file to save the rankings to, if one was given
+    bool topKOnly = false; // whether to rank only as much of each list as the queries ask for
+    bool incremental = false; // whether to keep ranking text that streams in on standard input
+    string statsFile = ""; // where to write the stats of the run ("-" for standard error), if they were asked for
+    const string usage = "Usage: ./bard [--threads <N>] [--corpus <PATH>]... [--top-k | --index <INDEX FILE>] <INPUT FILE> <OUTPUT FILE>\n"
+                         "       ./bard [--threads <N>] [--corpus <PATH>]... --incremental <OUTPUT FILE>\n"
+                         "       ./bard [--threads <N>] [--corpus <PATH>]... --build-index <INDEX FILE>\n"
+                         "Every form also takes --stats or --stats-file <FILE>";
 
     /*
-     * With all of the words in their respective linked list, we have to go through each linked list and
-     * 1. remove duplicate words
-     * 2. sort the list
-     * 3. reverse the list (the list order will become decreasing order of frequency and increasing lexicographic order)
+     * Options come before the input and output files:
+     * --threads <N>: count and rank with N worker threads instead of one per core
+     * --corpus <PATH>: read the corpus from PATH, a file or a directory of files, instead of shakespeare-cleaned5.txt.
+     *                  Can be given more than once
+     * --build-index <INDEX FILE>: rank the corpus once and save the rankings to INDEX FILE
+     * --index <INDEX FILE>: map the rankings saved in INDEX FILE and answer the queries right away
+     * --top-k: read the queries first, and rank only the top of each list, up to the highest rank queried
+     * --incremental: answer queries from standard input while more text streams in on it
+     * --stats: write the time, allocations and memory use of the run to standard error as JSON
+     * --stats-file <FILE>: write them to FILE instead
      */
-    for(int i = 0; i < wordsListSize; i++) {
-        wordsList[i].removeDuplicates();
-        wordsList[i].sortLists();
-        wordsList[i].reverse();
+    int argIndex = 1;
+    while (argIndex < argc && strncmp(argv[argIndex], "--", 2) == 0) { // loop through the options
+        string option = argv[argIndex];
+        if (option == "--top-k" || option == "--incremental" || option == "--stats") { // options without a value
+            topKOnly = topKOnly || (option == "--top-k");
+            incremental = incremental || (option == "--incremental");
+            if (option == "--stats") {
+                statsFile = "-";
+            }
+            argIndex++;
+            continue;
+        }
+        if (argIndex + 1 >= argc) { // every other option takes a value
+            throw std::invalid_argument(usage); // throw error
+        }
+        if (option == "--threads") {
+            numThreads = atoi(argv[argIndex + 1]);
+            if (numThreads < 1) {
+                throw std::invalid_argument(usage); // throw error
+            }
+        } else if (option == "--corpus") {
+            listCorpusFiles(argv[argIndex + 1], corpusFiles);
+        } else if (option == "--build-index") {
+            buildIndexFile = argv[argIndex + 1];
+        } else if (option == "--index") {
+            indexFile = argv[argIndex + 1];
+        } else if (option == "--stats-file") {
+            statsFile = argv[argIndex + 1];
+        } else { // unknown option
+            throw std::invalid_argument(usage); // throw error
+        }
+        argIndex += 2;
     }
-    
+    argc -= argIndex - 1; // the remaining arguments are the input and output files
+    argv += argIndex - 1;
+    if (corpusFiles.empty()) {
+        corpusFiles.push_back("shakespeare-cleaned5.txt"); // the full text of all compositions of Shakespeare
+    }
+
+    RunStats stats; // the phases of the run, written out at the end if --stats was given
+    stats.numThreads = numThreads;
+    if (!statsFile.empty()) { // only a run that reports its stats pays for counting allocations
+        startCountingAllocations();
+    }
+
+    if (!buildIndexFile.empty()) {
+        stats.mode = "build-index";
+        WordPool wordPool;
+        vector<NodePool> nodePools;
+        vector<WordList> wordsList;
+        stats.startPhase("load");
+        loadWordsLists(corpusFiles, numThreads, wordPool, nodePools, wordsList);
+        recordBucketSizes(stats, wordsList);
+        stats.startPhase("sort");
+        rankWordsLists(wordsList, numThreads, vector<int>());
+
+        stats.startPhase("freeze");
+        RankIndex rankIndex;
+        rankIndex.build(wordsList);
+        stats.startPhase("write");
+        if (!rankIndex.save(buildIndexFile)) {
+            throw std::runtime_error("Could not write " + buildIndexFile); // throw error
+        }
+        reportStats(stats, statsFile);
+        return 0;
+    }
+
+    if (incremental) {
+        if (argc < 2) { // must provide the output file
+            throw std::invalid_argument(usage); // throw error
+        }
+        stats.mode = "incremental";
+        runIncremental(corpusFiles, numThreads, argv[1], stats);
+        reportStats(stats, statsFile);
+        return 0;
+    }
+
+    if (argc < 3) {// must provide two arguments as input
+      throw std::invalid_argument(usage); // throw error
+    }
+    ofstream output; // stream for output file
+
     /*
-     * With the lists sorted now, we need to handle input from the file and export the results to the output file
+     * Read every query from the input file before ranking, so that the ranking can be limited to what is queried.
+     * The whole file is mapped and parsed in place, and stays mapped until the queries are answered, since the
+     * prefixes of prefix queries point into it
      */
-    input.open(argv[1]); // open input file
+    stats.mode = "query";
+    stats.startPhase("parse");
+    Corpus input; // the mapped input file
+    if (!input.open(argv[1])) { // open input file
+        throw std::runtime_error("Could not open " + string(argv[1])); // throw error
+    }
+    vector<Query> queries; // every (LENGTH, RANK) pair in the input file, in order
+    parseQueries(input.data(), input.size(), queries);
+    bool hasPrefixQueries = false; // whether any query needs the prefix trie
+    for (size_t i = 0; i < queries.size(); i++) {
+        hasPrefixQueries = hasPrefixQueries || !queries[i].prefix.empty();
+    }
+
+    RankIndex rankIndex; // the rankings, frozen into one bucket of parallel arrays per word length
+    int maxWordLength = 0;
+    if (indexFile.empty()) { // rank the corpus from scratch
+        WordPool wordPool; // the characters of every unique word
+        vector<NodePool> nodePools; // the Nodes of every WordList
+        vector<WordList> wordsList; // wordsList[n] holds the unique words of length n, in rank order
+        stats.startPhase("load");
+        loadWordsLists(corpusFiles, numThreads, wordPool, nodePools, wordsList);
+        recordBucketSizes(stats, wordsList);
+        maxWordLength = (int) wordsList.size() - 1;
+
+        // With --top-k, every list only needs to be ranked up to the highest rank queried for its length
+        // A prefix query can ask for a word anywhere in its list, so those need every list fully ranked
+        vector<int> rankLimits;
+        if (topKOnly && !hasPrefixQueries) {
+            rankLimits.assign(wordsList.size(), 0); // a length that is never queried needs no ranking at all
+            for (size_t i = 0; i < queries.size(); i++) {
+                int queryLength = queries[i].length, queryRank = queries[i].rank;
+                if (queryLength >= 0 && queryLength <= maxWordLength && queryRank >= 0) { // a valid query
+                    // a range query needs every rank up to the end of its range
+                    long long queryEnd = (long long) queryRank + (queries[i].range ? max(queries[i].count, 1) : 1);
+                    rankLimits[queryLength] = max(rankLimits[queryLength], (int) min(queryEnd, (long long) INT_MAX));
+                }
+            }
+        }
+        stats.startPhase("sort");
+        rankWordsLists(wordsList, numThreads, rankLimits);
+
+        // Freeze the ranked lists into the index, which copies the words out, so the lists can be deleted
+        stats.startPhase("freeze");
+        rankIndex.build(wordsList);
+        for (size_t i = 0; i < wordsList.size(); i++) { // loop through all linked lists
+            wordsList[i].deleteList(); // delete the linked list
+        }
+    } else { // the rankings were already built, so just map them
+        stats.startPhase("load");
+        if (!rankIndex.load(indexFile)) {
+            throw std::runtime_error("Could not load index file " + indexFile); // throw error
+        }
+        maxWordLength = rankIndex.maxWordLength();
+        vector<int> bucketSizes;
+        for (int i = 0; i <= maxWordLength; i++) {
+            bucketSizes.push_back(rankIndex.bucket(i).size());
+        }
+        stats.setBucketSizes(bucketSizes);
+    }
+    PrefixIndex prefixIndex; // the counted trie over every word, built only when a query asks for a prefix
+    if (hasPrefixQueries) {
+        stats.startPhase("prefix");
+        prefixIndex.build(rankIndex);
+    }
+    /*
+     * With the lists sorted now, we need to answer the queries and export the results to the output file
+     */
+    stats.startPhase("query");
     output.open(argv[2]); // open output file
+    Writer outputWriter(output); // the answers are written to the output file in large blocks
     
-    int inputFileWordLength = 0, inputFileRank = 0; // initialize int variables to store the query numbers from the input file
-    while (input >> inputFileWordLength >> inputFileRank) { // loop through input file
-        string outputString = ""; // initalize string var to write back to the output file
+    for (size_t i = 0; i < queries.size(); i++) { // loop through the queries
+        int inputFileWordLength = queries[i].length;
+        int inputFileRank = queries[i].rank;
+        string_view outputString = ""; // initalize string var to write back to the output file
         // Check that:
         // 1. the queried word length is not greater than the largest maxWordLength and
         // 2. the queried word length is not negative and
         // 3. the queried rank is not negative
-        if ((inputFileWordLength > maxWordLength || inputFileWordLength < 0) || inputFileRank < 0) { 
+        if (!queries[i].prefix.empty()) {
+            // find the word among the words that start with the prefix, of every length or of the one length
+            if (queries[i].anyLength) {
+                outputString = prefixIndex.findRank(queries[i].prefix, inputFileRank);
+            } else {
+                outputString = prefixIndex.findRank(queries[i].prefix, inputFileWordLength, inputFileRank);
+            }
+        }
+        else if ((inputFileWordLength > maxWordLength || inputFileWordLength < 0) || inputFileRank < 0) { 
             outputString = "-"; // the word will not exist in this list
         } 
+        else if (queries[i].range) {
+            // write the whole range of ranks on one line, straight from the bucket
+            RankedBucket range = rankIndex.bucket(inputFileWordLength).slice(inputFileRank, queries[i].count);
+            if (range.size() == 0) { // no words in the range
+                outputString = "-";
+            } else {
+                for (int rank = 0; rank + 1 < range.size(); rank++) {
+                    outputWriter.write(range.word(rank));
+                    outputWriter.write(' ');
+                }
+                outputString = range.word(range.size() - 1);
+            }
+        }
         else {
-            // find the word corresponding to the input length and rank
-            outputString =  wordsList[inputFileWordLength].findRankNode(inputFileRank);
+            // find the word corresponding to the input length and rank in its bucket
+            outputString = rankIndex.findRank(inputFileWordLength, inputFileRank);
         }
-        output << outputString << "\n"; // write the output string to the output file
+        outputWriter.writeLine(outputString); // write the output string to the output file
     }
+    stats.startPhase("write");
+    outputWriter.flush(); // write whatever is left before the output file is closed
     
-    // Delete all linked lists
-    for(int i = 0; i < wordsListSize; i++) { // loop through all linked lists
-        wordsList[i].deleteList(); // delete the linked list
-    }
-
     // Close the input and output files
     input.close();
     output.close(); 
 
+    reportStats(stats, statsFile);
     return 0;
 }
@@ -0,0 +1,202 @@
+// Filename: corpus.cpp
+//
+// Contains the class Corpus that maps a text file into memory, and the single pass loaders that count
+// the words of the text into buckets by length without copying any of them, for one file or many files
+// at once in parallel.
+
+#include "corpus.h"
+#include "parallel.h"
+#include "scanner.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace std;
+
+// Default constructor, nothing is mapped
+Corpus :: Corpus() {
+    text = NULL;
+    textSize = 0;
+}
+
+// Destructor unmaps the file
+Corpus :: ~Corpus() {
+    close();
+}
+
+// Map the file read-only into memory
+// Input: filename, the path of the text file
+// Output: Bool, whether the file could be mapped
+bool Corpus :: open(const string& filename) {
+    close(); // release any previously mapped file
+
+    int fd = ::open(filename.c_str(), O_RDONLY); // open the file for reading
+    if (fd < 0) { // the file does not exist or cannot be read
+        return false;
+    }
+
+    struct stat fileInfo;
+    if (fstat(fd, &fileInfo) < 0) { // could not get the size of the file
+        ::close(fd);
+        return false;
+    }
+
+    if (fileInfo.st_size > 0) { // mmap cannot map an empty file, which is simply an empty corpus
+        void* mapped = mmap(NULL, fileInfo.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            ::close(fd);
+            return false;
+        }
+        madvise(mapped, fileInfo.st_size, MADV_SEQUENTIAL); // the loader reads the text front to back
+        text = static_cast<const char*>(mapped);
+        textSize = fileInfo.st_size;
+    }
+
+    ::close(fd); // the mapping stays valid after the descriptor is closed
+    return true;
+}
+
+// Unmap the file, if one is mapped
+// Input: None
+// Output: None
+void Corpus :: close() {
+    if (text != NULL) {
+        munmap(const_cast<char*>(text), textSize);
+    }
+    text = NULL;
+    textSize = 0;
+}
+
+// Large files are cut into slices of about this many bytes, so that several workers can count one file
+const size_t SHARD_SIZE = 32 << 20;
+
+// Count every line of corpus as one word, into the bucket for its length. Lines are split the same way
+// getline does: on '\n', with a final line that has no '\n' still counted
+// Input: corpus, the mapped text. wordCounts, the buckets to count into (grown as longer words are found)
+// Output: Long, the number of words read
+long countWordsByLength(const Corpus& corpus, vector<WordCounts>& wordCounts) {
+    return countWordsByLength(corpus.data(), corpus.data() + corpus.size(), wordCounts);
+}
+
+// Count every line from begin up to end as one word, into the bucket for its length
+// Input: begin and end, the text. wordCounts, the buckets to count into (grown as longer words are found)
+// Output: Long, the number of words read
+long countWordsByLength(const char* begin, const char* end, vector<WordCounts>& wordCounts) {
+    const char* curr = begin; // start of the current line
+    long numWords = 0;
+
+    while (curr < end) { // loop through every line of the text
+        const char* lineEnd = findByte(curr, end, '\n'); // the last line may not end in '\n', so this may be end
+        size_t wordLen = lineEnd - curr; // length of the current word
+
+        if (wordLen >= wordCounts.size()) { // first word this long, so grow the buckets to fit it
+            wordCounts.resize(wordLen + 1);
+        }
+        wordCounts[wordLen][string_view(curr, wordLen)]++; // count the word (a new word starts at 0)
+        numWords++;
+
+        curr = lineEnd + 1; // move past the '\n'
+    }
+
+    return numWords;
+}
+
+// Expand a path into corpus files
+// Input: path, a file or a directory. filenames, where the files are appended
+// Output: None
+void listCorpusFiles(const string& path, vector<string>& filenames) {
+    if (!filesystem::is_directory(path)) { // a single file (opening it will report if it does not exist)
+        filenames.push_back(path);
+        return;
+    }
+
+    vector<string> found; // every regular file under the directory
+    for (filesystem::recursive_directory_iterator dirIter(path); dirIter != filesystem::recursive_directory_iterator(); ++dirIter) {
+        if (dirIter->is_regular_file()) {
+            found.push_back(dirIter->path().string());
+        }
+    }
+    sort(found.begin(), found.end()); // directory order is arbitrary, so sort to make runs repeatable
+    filenames.insert(filenames.end(), found.begin(), found.end());
+}
+
+// Map and count every file, in parallel shards
+// Input: filenames, the files to read. numThreads, the number of worker threads. corpora, filled with the
+// mapped files. wordCounts, filled with the merged counts of every word, by length
+// Output: Long, the number of words read
+long countCorpusFiles(const vector<string>& filenames, int numThreads, vector<unique_ptr<Corpus>>& corpora,
+                      vector<WordCounts>& wordCounts) {
+    // Map every file first, so a missing file is reported before any work starts
+    corpora.clear();
+    for (size_t i = 0; i < filenames.size(); i++) {
+        corpora.push_back(unique_ptr<Corpus>(new Corpus()));
+        if (!corpora.back()->open(filenames[i])) {
+            throw std::runtime_error("Could not open " + filenames[i]); // throw error
+        }
+    }
+
+    // Cut the text into shards: whole files, with large files cut into slices that end on a line boundary
+    vector<pair<const char*, const char*>> shards;
+    for (size_t i = 0; i < corpora.size(); i++) {
+        const char* curr = corpora[i]->data();
+        const char* end = curr + corpora[i]->size();
+        while (curr < end) {
+            const char* shardEnd = end;
+            if ((size_t) (end - curr) > SHARD_SIZE) { // cut after the first '\n' past SHARD_SIZE bytes
+                const char* newline = findByte(curr + SHARD_SIZE, end, '\n');
+                shardEnd = (newline == end) ? end : newline + 1;
+            }
+            shards.push_back(make_pair(curr, shardEnd));
+            curr = shardEnd;
+        }
+    }
+
+    // Count the biggest shards first, each worker into its own buckets
+    vector<int> shardOrder(shards.size());
+    for (size_t i = 0; i < shards.size(); i++) {
+        shardOrder[i] = i;
+    }
+    stable_sort(shardOrder.begin(), shardOrder.end(), [&](int left, int right) {
+        return shards[left].second - shards[left].first > shards[right].second - shards[right].first;
+    });
+    vector<vector<WordCounts>> workerCounts(max(numThreads, 1)); // workerCounts[w][n] counts the words of length n seen by worker w
+    atomic<long> numWords(0);
+    int numWorkers = runWorkerTasks(shardOrder, [&](int shard, int worker) {
+        numWords += countWordsByLength(shards[shard].first, shards[shard].second, workerCounts[worker]);
+    }, numThreads);
+    workerCounts.resize(numWorkers);
+
+    // Merge the buckets of every worker, one word length at a time
+    size_t numLengths = 0;
+    for (int worker = 0; worker < numWorkers; worker++) {
+        numLengths = max(numLengths, workerCounts[worker].size());
+    }
+    wordCounts.assign(numLengths, WordCounts());
+    vector<int> lengths(numLengths);
+    for (size_t i = 0; i < numLengths; i++) {
+        lengths[i] = i;
+    }
+    runTasks(lengths, [&](int length) {
+        for (int worker = 0; worker < numWorkers; worker++) {
+            if ((int) workerCounts[worker].size() <= length) { // this worker never saw a word this long
+                continue;
+            }
+            WordCounts& counts = workerCounts[worker][length];
+            if (wordCounts[length].empty()) { // nothing to merge into yet, so just take the worker's bucket
+                wordCounts[length].swap(counts);
+                continue;
+            }
+            for (WordCounts::iterator freqIter = counts.begin(); freqIter != counts.end(); ++freqIter) {
+                wordCounts[length][freqIter->first] += freqIter->second;
+            }
+            WordCounts().swap(counts); // free the worker's bucket as soon as it is merged
+        }
+    }, numThreads);
+
+    return numWords;
+}
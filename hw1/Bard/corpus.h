@@ -0,0 +1,56 @@
+// Filename: corpus.h
+//
+// Header file for the class Corpus, a read-only memory mapping of a text file with one word per line,
+// and the loaders that count every word of one or many Corpus files into buckets by word length
+
+#ifndef CORPUS_H
+#define CORPUS_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+// Frequency of every unique word in a bucket. The keys point into the Corpus the words were read from,
+// so a Corpus must outlive the counts that were loaded from it
+typedef unordered_map<string_view, int> WordCounts;
+
+class Corpus {
+    private:
+        const char* text; // Start of the mapped file (NULL if nothing is mapped)
+        size_t textSize; // Number of bytes in the mapped file
+    public:
+        Corpus(); // Default constructor, nothing is mapped
+        ~Corpus(); // Unmaps the file
+        Corpus(const Corpus&) = delete; // A mapping has a single owner
+        Corpus& operator=(const Corpus&) = delete;
+
+        bool open(const string& filename); // Map the file read-only. Returns false if it cannot be opened
+        void close(); // Unmap the file
+        const char* data() const { return text; } // Start of the text
+        size_t size() const { return textSize; } // Number of bytes of text
+};
+
+// Scan every line of corpus once and count each word into wordCounts[n], where n is the length of the
+// word. wordCounts grows to fit the longest word. Returns the number of words read
+long countWordsByLength(const Corpus& corpus, vector<WordCounts>& wordCounts);
+
+// Same as above, for the lines of text from begin up to end
+long countWordsByLength(const char* begin, const char* end, vector<WordCounts>& wordCounts);
+
+// Expand path into the corpus files it names, appended to filenames. A file names itself, and a directory names
+// every regular file under it, in sorted order
+void listCorpusFiles(const string& path, vector<string>& filenames);
+
+// Map every file in filenames and count all of their words into wordCounts, using numThreads worker threads. Each
+// worker counts its share of the text (whole files, or slices of large files) into its own buckets, and the
+// buckets are then merged one word length at a time. The counts point into the files, which stay mapped in corpora.
+// Throws runtime_error if a file cannot be opened. Returns the number of words read
+long countCorpusFiles(const vector<string>& filenames, int numThreads, vector<unique_ptr<Corpus>>& corpora,
+                      vector<WordCounts>& wordCounts);
+
+#endif
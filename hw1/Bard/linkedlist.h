@@ -1,6 +1,8 @@
 // Filename: linkedlist.h
 //
-// Header file for the class LinkedList that represents a linked list abstract data type
+// Header file for the class WordList, the linked list of words and their frequencies. It is the
+// LinkedList<T, Allocator> template (see ../../common/listtemplate.h) instantiated for a WordCount payload, with
+// its Nodes allocated from a NodePool, plus the ranking functions that only make sense for words.
 //
 // Japheth Frolick, August 2019
 // C. Seshadhri, Jan 2020
@@ -9,40 +11,34 @@
 #ifndef LIST_H
 #define LIST_H
 
-#include <string>
+#include <string_view>
+#include "listtemplate.h"
+#include "nodepool.h"
 
 using namespace std;
 
-// node struct to hold data
-struct Node {
-    string word; // word string from Shakespeare's text
+// payload of a Node. The characters of the word are not owned by the Node, they usually live in a WordPool
+struct WordCount {
+    string_view word; // word string from Shakespeare's text
     int frequency; // number of occurences of the word
-    Node* next;
+
+    WordCount(string_view text, int count) : word(text), frequency(count) {}
 };
 
-class LinkedList {
-    private:
-        Node* head; // Stores head of linked list
+class WordList : public LinkedList<WordCount, PoolAllocator<WordCount>> {
     public:
-        LinkedList(); // Default constructor sets head to null
-        void insert(string); // Insert word into list
-        Node* find(string); // Find word in list, and return pointer to node with that word. If there are multiple copies, this only finds one copy.
-        Node* deleteNode(string); // Remove a node with word (if it exists), and return pointer to deleted node. This does not delete all nodes with the value.
-        void deleteList(); // Deletes every node to prevent memory leaks and frees memory.
-        string print(); // Construct string with data of list in order
-        int length(); // Returns the length of the linked list
-	
-		// Advanced functions
-        void reverse(); // Helper function of reverseList(Node*) that sets the new head of the reversed list
-        Node* reverseList(Node* start); // Reverse the list starting from Node start
-        void removeDuplicates(); // Remove duplicate Nodes (a Node with the same word as another). Increment the frequency of the base Node as a Node is deleted
-        // Sorts the linked list in increasing order of frequency and decreasing lexicographic order. reverse()
-        // will be used in tangent to set the order to DECREASING order of frequency and INCREASING lexicographic
-        // order
-        void sortLists(); 
-        void swapWords(Node*&, Node*&); // Swap the word string between two Nodes
-        void swapFrequencies(Node*&, Node*&); // Swap the frequency between two Nodes
-        string findRankNode(int); // Find the word in the list that is val ranked
+        explicit WordList(NodePool* pool); // Constructor for a list that allocates all of its Nodes from the pool
+        // Insert word into list with an already counted frequency. The list only stores a view of the word, so its
+        // characters must outlive the list
+        void insert(string_view word, int frequency) { emplace(word, frequency); }
+
+        // Advanced functions
+        void sortLists(); // Sorts the linked list in decreasing order of frequency and increasing lexicographic order
+        void sortTopK(int k); // Keep only the k highest ranked Nodes, in the same order sortLists() would put them
+
+        static bool ranksBefore(const WordCount&, const WordCount&); // Whether the first word is ranked before the second word
 };
 
+typedef WordList::Node Node;
+
 #endif
@@ -0,0 +1,53 @@
+// Filename: parallel.cpp
+//
+// Contains a small pool of worker threads. Every worker repeatedly claims the next task that has not been
+// started yet, so a few long tasks do not hold up the short ones.
+
+#include "parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+using namespace std;
+
+// Number of worker threads to use by default
+// Input: None
+// Output: Int, the number of cores (at least 1)
+int defaultThreadCount() {
+    return max(1, (int) thread::hardware_concurrency());
+}
+
+// Run every task on a pool of worker threads
+// Input: tasks, the arguments to call task with, in the order to start them. task, the work to do.
+// numThreads, the number of worker threads
+// Output: None, returns once every task has finished
+void runTasks(const vector<int>& tasks, const function<void(int)>& task, int numThreads) {
+    runWorkerTasks(tasks, [&](int taskArgument, int) { task(taskArgument); }, numThreads);
+}
+
+// Run every task on a pool of worker threads, telling each task which worker it runs on
+// Input: tasks, the arguments to call task with, in the order to start them. task, the work to do.
+// numThreads, the most worker threads to use
+// Output: Int, the number of workers that were used. Returns once every task has finished
+int runWorkerTasks(const vector<int>& tasks, const function<void(int, int)>& task, int numThreads) {
+    numThreads = min(max(numThreads, 1), max((int) tasks.size(), 1)); // no point in idle workers
+    if (numThreads == 1) { // not worth starting a thread
+        for (size_t i = 0; i < tasks.size(); i++) {
+            task(tasks[i], 0);
+        }
+        return 1;
+    }
+
+    atomic<size_t> nextTask(0); // index of the next task that has not been claimed by a worker
+    vector<thread> workers;
+    for (int worker = 0; worker < numThreads; worker++) { // start the workers
+        workers.push_back(thread([&, worker]() {
+            for (size_t claimed = nextTask++; claimed < tasks.size(); claimed = nextTask++) { // claim tasks until none are left
+                task(tasks[claimed], worker);
+            }
+        }));
+    }
+    for (size_t i = 0; i < workers.size(); i++) { // wait for every worker to finish
+        workers[i].join();
+    }
+    return numThreads;
+}
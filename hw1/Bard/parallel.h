@@ -0,0 +1,26 @@
+// Filename: parallel.h
+//
+// Header file for a small pool of worker threads that runs independent tasks
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <functional>
+#include <vector>
+
+using namespace std;
+
+// Number of worker threads to use by default: one per core
+int defaultThreadCount();
+
+// Run task(tasks[0]), task(tasks[1]), ... on a pool of numThreads worker threads, and wait for all of them
+// to finish. Tasks are started in the order they are listed, so the longest tasks should be listed first.
+// The tasks must be independent of each other
+void runTasks(const vector<int>& tasks, const function<void(int)>& task, int numThreads);
+
+// Same as runTasks, but also tells each task which worker runs it, as task(taskArgument, worker) with worker in
+// [0, numWorkers). Tasks run by the same worker never overlap, so they can share per worker state without locking.
+// Returns the number of workers used
+int runWorkerTasks(const vector<int>& tasks, const function<void(int, int)>& task, int numThreads);
+
+#endif
@@ -0,0 +1,149 @@
+// Filename: prefixindex.cpp
+//
+// Contains the class PrefixIndex. Every node of the trie keeps its own list of the words under it, twice: sorted
+// by overall rank, and sorted by length and rank. A prefix query is then a walk down the trie and a single index
+// (plus two binary searches to find one length).
+
+#include "prefixindex.h"
+#include <algorithm>
+using namespace std;
+
+// Build the trie over the vocabulary of the index
+// Input: rankIndex, the ranked words of every length
+// Output: None
+void PrefixIndex :: build(const RankIndex& rankIndex) {
+    // Number every word by length, and then by rank within its length
+    words.clear();
+    lengthStarts.clear();
+    vector<uint32_t> frequencies;
+    for (int i = 0; i <= rankIndex.maxWordLength(); i++) { // loop through every length
+        lengthStarts.push_back(words.size());
+        for (RankedBucket::Entry entry : rankIndex.bucket(i)) { // loop through its words in rank order
+            words.push_back(entry.word);
+            frequencies.push_back(entry.frequency);
+        }
+    }
+    lengthStarts.push_back(words.size());
+    uint32_t numWords = words.size();
+
+    // The overall rank of every word: decreasing order of frequency and increasing lexicographic order
+    vector<uint32_t> rankOrder(numWords);
+    for (uint32_t i = 0; i < numWords; i++) {
+        rankOrder[i] = i;
+    }
+    sort(rankOrder.begin(), rankOrder.end(), [&](uint32_t left, uint32_t right) {
+        if (frequencies[left] != frequencies[right]) {
+            return frequencies[left] > frequencies[right];
+        }
+        return words[left] < words[right];
+    });
+
+    // Insert every word, counting the words under every node on the way down
+    nodes.assign(1, PrefixNode{'\0', -1, -1, 0, numWords}); // the root holds every word
+    vector<int> parents(1, -1); // the parent of every node, to walk from a word back up to the root
+    vector<int> wordNodes(numWords); // the node every word ends at
+    for (uint32_t i = 0; i < numWords; i++) { // loop through every word
+        int curr = 0; // start at the root
+        for (char letter : words[i]) { // walk down the trie, adding the nodes that are missing
+            int child = nodes[curr].firstChild;
+            int lastChild = -1;
+            while (child != -1 && nodes[child].letter != letter) {
+                lastChild = child;
+                child = nodes[child].nextSibling;
+            }
+            if (child == -1) { // no word so far starts with this prefix
+                child = nodes.size();
+                nodes.push_back(PrefixNode{letter, -1, -1, 0, 0});
+                parents.push_back(curr);
+                if (lastChild == -1) {
+                    nodes[curr].firstChild = child;
+                } else {
+                    nodes[lastChild].nextSibling = child;
+                }
+            }
+            nodes[child].numEntries++; // one more word under this prefix
+            curr = child;
+        }
+        wordNodes[i] = curr;
+    }
+
+    // Give every node its run of entries
+    uint32_t totalEntries = 0;
+    for (size_t i = 0; i < nodes.size(); i++) {
+        nodes[i].entriesStart = totalEntries;
+        totalEntries += nodes[i].numEntries;
+    }
+
+    // Every word is appended to the run of each node on its path. Going through the words in overall rank order
+    // (and then in number order) leaves every run already sorted, so no run has to be sorted on its own
+    byRank.resize(totalEntries);
+    byLength.resize(totalEntries);
+    vector<uint32_t> rankFill(nodes.size()); // where the next word goes in the run of every node
+    vector<uint32_t> lengthFill(nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++) {
+        rankFill[i] = nodes[i].entriesStart;
+        lengthFill[i] = nodes[i].entriesStart;
+    }
+    for (uint32_t i = 0; i < numWords; i++) { // loop through the words in overall rank order
+        for (int node = wordNodes[rankOrder[i]]; node != -1; node = parents[node]) {
+            byRank[rankFill[node]++] = rankOrder[i];
+        }
+    }
+    for (uint32_t i = 0; i < numWords; i++) { // loop through the words by length and then rank
+        for (int node = wordNodes[i]; node != -1; node = parents[node]) {
+            byLength[lengthFill[node]++] = i;
+        }
+    }
+}
+
+// Find the node of the trie for a prefix
+// Input: prefix, the characters the words start with
+// Output: Int, the index of the node, or -1 if no word starts with prefix
+int PrefixIndex :: findNode(string_view prefix) const {
+    if (nodes.empty()) { // the trie was never built
+        return -1;
+    }
+    int curr = 0; // start at the root
+    for (char letter : prefix) { // walk down the trie one character at a time
+        int child = nodes[curr].firstChild;
+        while (child != -1 && nodes[child].letter != letter) {
+            child = nodes[child].nextSibling;
+        }
+        if (child == -1) { // no word continues the prefix with letter
+            return -1;
+        }
+        curr = child;
+    }
+    return curr;
+}
+
+// Find the word that starts with prefix and is ranked rank among all such words
+// Input: prefix, the characters the word starts with. rank, its ranking among the words that start with prefix
+// Output: String, the word, or "-" if there is no such word
+string_view PrefixIndex :: findRank(string_view prefix, int rank) const {
+    int node = findNode(prefix);
+    if (node == -1 || rank < 0 || rank >= (int) nodes[node].numEntries) { // not enough words with the prefix
+        return "-";
+    }
+    return words[byRank[nodes[node].entriesStart + rank]];
+}
+
+// Find the word of the given length that starts with prefix and is ranked rank among all such words
+// Input: prefix, the characters the word starts with. length, the length of the word. rank, its ranking among
+// the words of that length that start with prefix
+// Output: String, the word, or "-" if there is no such word
+string_view PrefixIndex :: findRank(string_view prefix, int length, int rank) const {
+    int node = findNode(prefix);
+    if (node == -1 || length < 0 || length + 1 >= (int) lengthStarts.size() || rank < 0) { // no such words, or an invalid query
+        return "-";
+    }
+    // The words of the node are sorted by number, so the words of one length are the run of numbers that length owns
+    vector<uint32_t>::const_iterator nodeBegin = byLength.begin() + nodes[node].entriesStart;
+    vector<uint32_t>::const_iterator nodeEnd = nodeBegin + nodes[node].numEntries;
+    vector<uint32_t>::const_iterator lengthBegin = lower_bound(nodeBegin, nodeEnd, lengthStarts[length]);
+    vector<uint32_t>::const_iterator lengthEnd = lower_bound(lengthBegin, nodeEnd, lengthStarts[length + 1]);
+    if (rank >= lengthEnd - lengthBegin) { // not enough words of that length with the prefix
+        return "-";
+    }
+    return words[lengthBegin[rank]];
+}
@@ -0,0 +1,42 @@
+// Filename: prefixindex.h
+//
+// Header file for the class PrefixIndex, a counted trie over the ranked vocabulary that answers
+// "the word ranked R among words that start with PREFIX", over every length or over a single length
+
+#ifndef PREFIXINDEX_H
+#define PREFIXINDEX_H
+
+#include "rankindex.h"
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+// A node of the trie, for the prefix spelled by the path from the root. Its words are a contiguous run of
+// entries in byRank and byLength, numEntries long, so the number of words under a prefix is known right away
+struct PrefixNode {
+    char letter; // Last character of the prefix
+    int firstChild; // First node one character longer (-1 if there is none)
+    int nextSibling; // Next node with the same parent (-1 if there is none)
+    uint32_t entriesStart; // Where the words with this prefix start in byRank and byLength
+    uint32_t numEntries; // Number of words with this prefix
+};
+
+class PrefixIndex {
+    private:
+        vector<string_view> words; // Every word, numbered by length and then by rank within its length
+        vector<uint32_t> lengthStarts; // The words of length n are numbered lengthStarts[n] up to lengthStarts[n + 1]
+        vector<PrefixNode> nodes; // nodes[0] is the root, the empty prefix
+        vector<uint32_t> byRank; // The words under every node, in decreasing order of frequency and increasing lexicographic order
+        vector<uint32_t> byLength; // The words under every node, by length and then by rank (that is, by their number)
+
+        int findNode(string_view prefix) const; // The node for prefix, or -1 if no word starts with it
+    public:
+        // Build the trie over every word in rankIndex. The trie points at the words in rankIndex, so it must outlive the trie
+        void build(const RankIndex& rankIndex);
+        string_view findRank(string_view prefix, int rank) const; // The word with prefix ranked rank among words of every length, or "-"
+        string_view findRank(string_view prefix, int length, int rank) const; // The word with prefix ranked rank among words of this length, or "-"
+};
+
+#endif
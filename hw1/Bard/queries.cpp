@@ -0,0 +1,107 @@
+// Filename: queries.cpp
+//
+// Contains the query stage of bard. The input file is parsed in place with a hand written integer parser
+// instead of operator>>. The answers are written back through a Writer (see writer.h).
+
+#include "queries.h"
+#include "scanner.h"
+#include <climits>
+#include <cstring>
+using namespace std;
+
+// Parse the next integer at curr
+// Input: curr, where to start parsing (moved past the integer). end, the end of the text. value, set to the integer
+// Output: Bool, whether an integer that fits in an int was parsed
+bool parseInt(const char*& curr, const char* end, int& value) {
+    curr = skipSpace(curr, end); // skip whitespace before the integer
+
+    bool negative = false;
+    if (curr < end && (*curr == '-' || *curr == '+')) { // optional sign
+        negative = (*curr == '-');
+        curr++;
+    }
+    if (curr == end || *curr < '0' || *curr > '9') { // there has to be at least one digit
+        return false;
+    }
+
+    long long number = 0;
+    while (curr < end && *curr >= '0' && *curr <= '9') { // read every digit
+        number = number * 10 + (*curr - '0');
+        if (number > (long long) INT_MAX + 1) { // too big for an int, whatever the sign
+            return false;
+        }
+        curr++;
+    }
+    if (negative) {
+        number = -number;
+    }
+    if (number > INT_MAX) { // only INT_MIN has a magnitude of INT_MAX + 1
+        return false;
+    }
+
+    value = (int) number;
+    return true;
+}
+
+// Skip the blanks after a number, and parse one more integer if it is on the same line
+// Input: curr, where to start (moved past the integer, if there is one). end, the end of the text. value, set to the integer
+// Output: Bool, whether there was an integer on the same line
+bool parseIntOnLine(const char*& curr, const char* end, int& value) {
+    // Only blanks are skipped, so that a newline ends the query instead of reading the next query as part of it
+    while (curr < end && (*curr == ' ' || *curr == '\t' || *curr == '\r')) {
+        curr++;
+    }
+    if (curr == end || *curr == '\n') {
+        return false;
+    }
+    const char* start = curr;
+    if (!parseInt(curr, end, value)) { // not a number, so leave it for the next query to stop on
+        curr = start;
+        return false;
+    }
+    return true;
+}
+
+// Whether there is no newline from begin up to end
+inline bool onOneLine(const char* begin, const char* end) {
+    return memchr(begin, '\n', end - begin) == NULL;
+}
+
+// Parse every query in text. A third number only counts (as the COUNT of a range query, or the RANK of a prefix query
+// with a LENGTH) when the whole query is on one line. A query whose first two numbers are on different lines is a
+// plain pair, the way operator>> reads it, so "5\n3 4" is still the pair (5, 3) followed by a query that starts with 4
+// Input: text and size, the contents of the input file. queries, where the parsed queries are appended
+// Output: None
+void parseQueries(const char* text, size_t size, vector<Query>& queries) {
+    const char* curr = text;
+    const char* end = text + size;
+    Query query;
+    while (true) { // loop through every query
+        curr = skipSpace(curr, end);
+        const char* start = curr;
+        if (parseInt(curr, end, query.length)) { // "LENGTH RANK" or "LENGTH RANK_START COUNT"
+            if (!parseInt(curr, end, query.rank)) {
+                return;
+            }
+            query.prefix = string_view();
+            query.anyLength = false;
+            query.count = 0;
+            // a third integer on the same line as the other two makes it a range query
+            query.range = onOneLine(start, curr) && parseIntOnLine(curr, end, query.count);
+        } else if (start < end && (*start < '0' || *start > '9')) { // a word, so "PREFIX RANK" or "PREFIX LENGTH RANK"
+            curr = findSpace(start, end);
+            query.prefix = string_view(start, curr - start);
+            if (!parseInt(curr, end, query.rank)) {
+                return;
+            }
+            query.range = false;
+            query.count = 0;
+            query.length = query.rank;
+            // with two numbers on the line of the prefix, the first is the length
+            query.anyLength = !(onOneLine(start, curr) && parseIntOnLine(curr, end, query.rank));
+        } else { // the end of the text, or a number too big for an int
+            return;
+        }
+        queries.push_back(query);
+    }
+}
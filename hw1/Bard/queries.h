@@ -0,0 +1,37 @@
+// Filename: queries.h
+//
+// Header file for the query stage of bard: parsing every query out of the input file at once
+
+#ifndef QUERIES_H
+#define QUERIES_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+// A query from the input file: the length of the word, and its rank among words of that length. A range query
+// "LENGTH RANK_START COUNT" asks for the count words ranked from rank on, all on one line of the output. A prefix
+// query "PREFIX RANK" or "PREFIX LENGTH RANK" asks for the word ranked rank among the words that start with PREFIX
+struct Query {
+    int length;
+    int rank;
+    bool range; // Whether this is a range query
+    int count; // Number of words in the range (only for a range query)
+    string_view prefix; // The prefix of a prefix query, pointing into the parsed text (empty for every other query)
+    bool anyLength; // Whether a prefix query ranks the words of every length together (it has no LENGTH)
+};
+
+// Parse the next integer at curr, skipping any whitespace before it, and move curr past it. Returns false (and
+// leaves curr where parsing stopped) if there is no integer, or if it does not fit in an int
+bool parseInt(const char*& curr, const char* end, int& value);
+
+// Parse every "LENGTH RANK" pair in text, in order, along with the COUNT of a range query "LENGTH RANK_START COUNT"
+// when all three integers are on one line. A query that starts with a word instead of a number is a prefix query,
+// "PREFIX RANK" or "PREFIX LENGTH RANK" (the second form on one line). Every other query is read token by token,
+// like operator>>, and parsing stops at the first query that is missing a number
+void parseQueries(const char* text, size_t size, vector<Query>& queries);
+
+#endif
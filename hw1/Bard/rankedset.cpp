@@ -0,0 +1,256 @@
+// Filename: rankedset.cpp
+//
+// Contains the class RankedWordSet, an AVL tree that also keeps the size of every subtree so that it can
+// answer rank queries, and the class IncrementalRanker, which uses one of those trees per word length to
+// keep bard's rankings current as words stream in.
+
+#include "rankedset.h"
+#include <algorithm>
+using namespace std;
+
+// Default constructor, the set is empty
+RankedWordSet :: RankedWordSet() {
+    root = NULL;
+}
+
+// Destructor frees every node
+RankedWordSet :: ~RankedWordSet() {
+    deleteTree(root);
+}
+
+// Move constructor, takes over the nodes of other and leaves it empty
+RankedWordSet :: RankedWordSet(RankedWordSet&& other) noexcept {
+    root = other.root;
+    other.root = NULL;
+}
+
+// Frees every node in the subtree rooted at start
+// Input: start, the root of the subtree
+// Output: None
+void RankedWordSet :: deleteTree(RankedNode* start) {
+    if (start == NULL) {
+        return;
+    }
+    deleteTree(start->left);
+    deleteTree(start->right);
+    delete start;
+}
+
+// Whether (leftFrequency, leftWord) is ranked before (rightFrequency, rightWord)
+// Input: The frequency and word of two entries
+// Output: Bool, whether the left entry comes first in decreasing order of frequency and increasing lexicographic order
+bool RankedWordSet :: ranksBefore(int leftFrequency, string_view leftWord, int rightFrequency, string_view rightWord) {
+    if (leftFrequency != rightFrequency) {
+        return leftFrequency > rightFrequency;
+    }
+    return leftWord < rightWord;
+}
+
+// Recompute the height and subtree size of start from its children
+// Input: start, a node whose children are up to date
+// Output: None
+void RankedWordSet :: update(RankedNode* start) {
+    start->height = 1 + max(height(start->left), height(start->right));
+    start->subtreeSize = 1 + subtreeSize(start->left) + subtreeSize(start->right);
+}
+
+// Rotate the subtree rooted at start to the left, so that its right child becomes the root
+// Input: start, the root of the subtree
+// Output: The new root of the subtree
+RankedNode* RankedWordSet :: rotateLeft(RankedNode* start) {
+    RankedNode* newRoot = start->right;
+    start->right = newRoot->left;
+    newRoot->left = start;
+    update(start);
+    update(newRoot);
+    return newRoot;
+}
+
+// Rotate the subtree rooted at start to the right, so that its left child becomes the root
+// Input: start, the root of the subtree
+// Output: The new root of the subtree
+RankedNode* RankedWordSet :: rotateRight(RankedNode* start) {
+    RankedNode* newRoot = start->left;
+    start->left = newRoot->right;
+    newRoot->right = start;
+    update(start);
+    update(newRoot);
+    return newRoot;
+}
+
+// Restore the AVL invariant (the heights of the two subtrees differ by at most 1) at start, assuming it holds
+// in both subtrees
+// Input: start, the root of the subtree
+// Output: The new root of the subtree
+RankedNode* RankedWordSet :: balance(RankedNode* start) {
+    update(start);
+    int balanceFactor = height(start->left) - height(start->right);
+    if (balanceFactor > 1) { // left heavy
+        if (height(start->left->left) < height(start->left->right)) { // left-right case
+            start->left = rotateLeft(start->left);
+        }
+        return rotateRight(start);
+    }
+    if (balanceFactor < -1) { // right heavy
+        if (height(start->right->right) < height(start->right->left)) { // right-left case
+            start->right = rotateRight(start->right);
+        }
+        return rotateLeft(start);
+    }
+    return start;
+}
+
+// Add word to the set with the given frequency
+// Input: word, interned so that it outlives the set. frequency, the number of occurences of word
+// Output: None
+void RankedWordSet :: insert(string_view word, int frequency) {
+    RankedNode* to_insert = new RankedNode;
+    to_insert->word = word;
+    to_insert->frequency = frequency;
+    root = insert(root, to_insert);
+}
+
+// Insert the node to_insert into the subtree rooted at start
+// Input: start, the root of the subtree. to_insert, a node that is not in any tree
+// Output: The new root of the subtree
+RankedNode* RankedWordSet :: insert(RankedNode* start, RankedNode* to_insert) {
+    if (start == NULL) { // found the spot, to_insert becomes a leaf
+        to_insert->left = to_insert->right = NULL;
+        to_insert->height = 1;
+        to_insert->subtreeSize = 1;
+        return to_insert;
+    }
+    if (ranksBefore(to_insert->frequency, to_insert->word, start->frequency, start->word)) { // ranked earlier, so go left
+        start->left = insert(start->left, to_insert);
+    } else { // ranked later, so go right
+        start->right = insert(start->right, to_insert);
+    }
+    return balance(start);
+}
+
+// Remove word from the set
+// Input: word, and the frequency it currently has in the set
+// Output: Bool, whether word was found and removed
+bool RankedWordSet :: erase(string_view word, int frequency) {
+    RankedNode* erased = NULL;
+    root = erase(root, word, frequency, erased);
+    delete erased;
+    return erased != NULL;
+}
+
+// Detach the node holding (frequency, word) from the subtree rooted at start
+// Input: start, the root of the subtree. word and frequency, the entry to remove. erased, set to the detached node
+// Output: The new root of the subtree
+RankedNode* RankedWordSet :: erase(RankedNode* start, string_view word, int frequency, RankedNode*& erased) {
+    if (start == NULL) { // not in the set
+        return NULL;
+    }
+    if (ranksBefore(frequency, word, start->frequency, start->word)) { // it can only be on the left
+        start->left = erase(start->left, word, frequency, erased);
+        return balance(start);
+    }
+    if (ranksBefore(start->frequency, start->word, frequency, word)) { // it can only be on the right
+        start->right = erase(start->right, word, frequency, erased);
+        return balance(start);
+    }
+
+    // start holds the entry. Replace it with the first node of its right subtree, or with its left child
+    erased = start;
+    if (start->right == NULL) {
+        return start->left;
+    }
+    RankedNode* successor = NULL;
+    RankedNode* rightRest = eraseMin(start->right, successor);
+    successor->left = start->left;
+    successor->right = rightRest;
+    return balance(successor);
+}
+
+// Detach the first ranked node of the subtree rooted at start
+// Input: start, the root of a non-empty subtree. erased, set to the detached node
+// Output: The new root of the subtree
+RankedNode* RankedWordSet :: eraseMin(RankedNode* start, RankedNode*& erased) {
+    if (start->left == NULL) {
+        erased = start;
+        return start->right;
+    }
+    start->left = eraseMin(start->left, erased);
+    return balance(start);
+}
+
+// Move word to the rank of its new frequency. The node is reused, so nothing is allocated
+// Input: word, oldFrequency (its frequency in the set), newFrequency
+// Output: None
+void RankedWordSet :: changeFrequency(string_view word, int oldFrequency, int newFrequency) {
+    RankedNode* moved = NULL;
+    root = erase(root, word, oldFrequency, moved);
+    if (moved == NULL) { // word was not in the set, so just add it
+        insert(word, newFrequency);
+        return;
+    }
+    moved->frequency = newFrequency;
+    root = insert(root, moved);
+}
+
+// Find the word ranked rank, by walking down the tree using the subtree sizes
+// Input: rank, the ranking of the word (starting at 0)
+// Output: String, the word ranked rank, or "-" if there is none
+string_view RankedWordSet :: findRank(int rank) const {
+    if (rank < 0 || rank >= subtreeSize(root)) {
+        return "-";
+    }
+    RankedNode* curr = root;
+    while (curr != NULL) {
+        int leftSize = subtreeSize(curr->left); // number of words ranked before curr in its subtree
+        if (rank < leftSize) { // the word is in the left subtree
+            curr = curr->left;
+        } else if (rank == leftSize) { // found it
+            return curr->word;
+        } else { // the word is in the right subtree, skip curr and everything left of it
+            rank -= leftSize + 1;
+            curr = curr->right;
+        }
+    }
+    return "-";
+}
+
+// Count more occurences of word, moving it up the ranking of its length
+// Input: word, the word (need not outlive the call). count, how many more occurences to count
+// Output: None
+void IncrementalRanker :: addWord(string_view word, int count) {
+    if (word.size() >= wordsSets.size()) { // first word this long
+        wordsSets.resize(word.size() + 1);
+    }
+
+    unordered_map<string_view, int>::iterator freqIter = frequencies.find(word);
+    if (freqIter == frequencies.end()) { // a new word, so keep a copy of it and add it to its set
+        string_view interned = wordPool.intern(word);
+        frequencies[interned] = count;
+        wordsSets[word.size()].insert(interned, count);
+        return;
+    }
+
+    int oldFrequency = freqIter->second;
+    freqIter->second += count;
+    wordsSets[word.size()].changeFrequency(freqIter->first, oldFrequency, freqIter->second);
+}
+
+// Find the word of the given length that is ranked rank
+// Input: length, the length of the word. rank, the ranking of the word among words of that length
+// Output: String, the word, or "-" if there is none
+string_view IncrementalRanker :: findRank(int length, int rank) const {
+    if (length < 0 || length >= (int) wordsSets.size()) { // no words of that length
+        return "-";
+    }
+    return wordsSets[length].findRank(rank);
+}
+
+// Count the unique words of one length
+// Input: length, the length of the words
+// Output: Int, the number of unique words of that length seen so far
+int IncrementalRanker :: size(int length) const {
+    if (length < 0 || length >= (int) wordsSets.size()) { // no words of that length
+        return 0;
+    }
+    return wordsSets[length].size();
+}
@@ -0,0 +1,73 @@
+// Filename: rankedset.h
+//
+// Header file for the class RankedWordSet, an order statistic tree of words ordered by rank, and the class
+// IncrementalRanker, which keeps one RankedWordSet per word length up to date as new words stream in
+
+#ifndef RANKEDSET_H
+#define RANKEDSET_H
+
+#include "wordpool.h"
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+// AVL tree node, ordered by decreasing frequency and then increasing lexicographic order
+struct RankedNode {
+    string_view word; // the word, interned in a WordPool
+    int frequency; // number of occurences of the word
+    int height; // AVL property: height of the subtree rooted at this node (a leaf has height 1)
+    int subtreeSize; // number of nodes in the subtree rooted at this node, including itself
+    RankedNode *left, *right;
+};
+
+// A set of (frequency, word) pairs in rank order. Every subtree knows its size, so the word at a given rank
+// is found in O(log n), and a word can be moved when its frequency changes in O(log n)
+class RankedWordSet {
+    private:
+        RankedNode* root; // Stores root of tree
+
+        // Recursive versions of the public functions, on the subtree rooted at start. They return the new root
+        // of the subtree after rebalancing
+        RankedNode* insert(RankedNode* start, RankedNode* to_insert);
+        RankedNode* erase(RankedNode* start, string_view word, int frequency, RankedNode*& erased);
+        RankedNode* eraseMin(RankedNode* start, RankedNode*& erased);
+        void deleteTree(RankedNode* start);
+
+        // AVL functions
+        static int height(RankedNode* start) { return start == NULL ? 0 : start->height; }
+        static int subtreeSize(RankedNode* start) { return start == NULL ? 0 : start->subtreeSize; }
+        static void update(RankedNode* start); // Recompute height and subtreeSize from the children
+        static RankedNode* rotateLeft(RankedNode* start);
+        static RankedNode* rotateRight(RankedNode* start);
+        static RankedNode* balance(RankedNode* start); // Restore the AVL invariant at start
+        static bool ranksBefore(int leftFrequency, string_view leftWord, int rightFrequency, string_view rightWord);
+    public:
+        RankedWordSet(); // Default constructor, the set is empty
+        ~RankedWordSet(); // Frees every node
+        RankedWordSet(const RankedWordSet&) = delete; // Nodes have a single owner
+        RankedWordSet& operator=(const RankedWordSet&) = delete;
+        RankedWordSet(RankedWordSet&&) noexcept; // Take over the nodes of another set, so sets can live in a vector
+
+        void insert(string_view word, int frequency); // Add word with this frequency
+        bool erase(string_view word, int frequency); // Remove word, which must currently have this frequency
+        void changeFrequency(string_view word, int oldFrequency, int newFrequency); // Move word to the rank of its new frequency
+        string_view findRank(int rank) const; // The word ranked rank, or "-" if there is none
+        int size() const { return subtreeSize(root); } // Number of words in the set
+};
+
+// Keeps the words of every length ranked while new occurences of words keep arriving
+class IncrementalRanker {
+    private:
+        WordPool wordPool; // The characters of every word seen so far
+        unordered_map<string_view, int> frequencies; // Frequency of every word seen so far (keys live in wordPool)
+        vector<RankedWordSet> wordsSets; // wordsSets[n] ranks the words of length n
+    public:
+        void addWord(string_view word, int count = 1); // Count count more occurences of word, in O(log n)
+        string_view findRank(int length, int rank) const; // The word of this length ranked rank, or "-" if there is none
+        int maxWordLength() const { return (int) wordsSets.size() - 1; } // Length of the longest word seen so far
+        int size(int length) const; // Number of unique words of this length seen so far
+};
+
+#endif
@@ -0,0 +1,233 @@
+// Filename: rankindex.cpp
+//
+// Contains the class RankIndex, which flattens the ranked LinkedLists into a few arrays so that they
+// can be written to disk and mapped straight back into memory, ready to answer queries.
+
+#include "rankindex.h"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace std;
+
+// Identifies a bard index file, and the version of its layout
+const char RANK_INDEX_MAGIC[8] = {'B', 'A', 'R', 'D', 'I', 'D', 'X', '2'};
+
+// Default constructor, the index is empty
+RankIndex :: RankIndex() {
+    mapping = NULL;
+    mappingSize = 0;
+    numBuckets = 0;
+    bucketStarts = NULL;
+    wordOffsets = NULL;
+    frequencies = NULL;
+    pool = NULL;
+}
+
+// Destructor unmaps the index file, if there is one
+RankIndex :: ~RankIndex() {
+    if (mapping != NULL) {
+        munmap(const_cast<char*>(mapping), mappingSize);
+    }
+}
+
+// Copy the sorted, frozen lists into a new image and point the index at it
+// Input: wordsList, where wordsList[n] holds the words of length n in rank order
+// Output: None. Throws runtime_error if there are more words than the index can number
+void RankIndex :: build(vector<WordList>& wordsList) {
+    RankIndexHeader header;
+    memcpy(header.magic, RANK_INDEX_MAGIC, sizeof(header.magic));
+    header.numBuckets = wordsList.size();
+    header.numWords = 0;
+    header.poolSize = 0;
+    uint64_t numWords = 0;
+    for (size_t i = 0; i < wordsList.size(); i++) { // count the words and characters in every list
+        uint64_t listLength = wordsList[i].length();
+        numWords += listLength;
+        header.poolSize += i * listLength;
+    }
+    if (numWords > UINT32_MAX) { // words are numbered with 32-bit bucket starts, so they would wrap around
+        throw std::runtime_error("Too many words for a rank index");
+    }
+    header.numWords = numWords;
+
+    // Lay out the image: the header, then the three arrays, then the pool
+    size_t wordOffsetsAt = sizeof(RankIndexHeader);
+    size_t bucketStartsAt = wordOffsetsAt + (size_t) header.numWords * sizeof(uint64_t);
+    size_t frequenciesAt = bucketStartsAt + ((size_t) header.numBuckets + 1) * sizeof(uint32_t);
+    size_t poolAt = frequenciesAt + header.numWords * sizeof(uint32_t);
+    storage.assign(poolAt + header.poolSize, 0);
+
+    char* image = storage.data();
+    memcpy(image, &header, sizeof(header));
+    uint32_t* starts = reinterpret_cast<uint32_t*>(image + bucketStartsAt);
+    uint64_t* offsets = reinterpret_cast<uint64_t*>(image + wordOffsetsAt);
+    uint32_t* freqs = reinterpret_cast<uint32_t*>(image + frequenciesAt);
+    char* chars = image + poolAt;
+
+    uint32_t entry = 0; // index of the next word
+    uint64_t poolUsed = 0; // number of characters copied into the pool
+    for (size_t i = 0; i < wordsList.size(); i++) { // loop through every list, in order of word length
+        starts[i] = entry;
+        for (Node* curr = wordsList[i].getHead(); curr != NULL; curr = curr->next) { // loop through the list in rank order
+            offsets[entry] = poolUsed;
+            freqs[entry] = curr->data.frequency;
+            memcpy(chars + poolUsed, curr->data.word.data(), curr->data.word.size());
+            poolUsed += curr->data.word.size();
+            entry++;
+        }
+    }
+    starts[wordsList.size()] = entry;
+
+    attach(image, storage.size());
+}
+
+// Write the index image to a file
+// Input: filename, the path of the index file
+// Output: Bool, whether the whole index was written
+bool RankIndex :: save(const string& filename) const {
+    const char* image = (mapping != NULL) ? mapping : storage.data();
+    size_t imageSize = (mapping != NULL) ? mappingSize : storage.size();
+
+    ofstream indexFile(filename, ios::binary | ios::trunc);
+    indexFile.write(image, imageSize);
+    indexFile.close();
+    return !indexFile.fail();
+}
+
+// Memory map an index file and point the index at it
+// Input: filename, the path of an index file written by save()
+// Output: Bool, whether the file could be mapped and is a valid index
+bool RankIndex :: load(const string& filename) {
+    int fd = ::open(filename.c_str(), O_RDONLY); // open the file for reading
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat fileInfo;
+    if (fstat(fd, &fileInfo) < 0 || fileInfo.st_size < (off_t) sizeof(RankIndexHeader)) { // too small to hold a header
+        ::close(fd);
+        return false;
+    }
+
+    void* mapped = mmap(NULL, fileInfo.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // the mapping stays valid after the descriptor is closed
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+
+    if (mapping != NULL) { // replace any index that was mapped before
+        munmap(const_cast<char*>(mapping), mappingSize);
+    }
+    mapping = static_cast<const char*>(mapped);
+    mappingSize = fileInfo.st_size;
+    storage.clear();
+
+    return attach(mapping, mappingSize);
+}
+
+// Check that image holds a complete index, and point the views at its arrays
+// Input: image, the start of the index. imageSize, the number of bytes in it
+// Output: Bool, whether the image is a valid index. If it is not, the index is left empty
+bool RankIndex :: attach(const char* image, size_t imageSize) {
+    numBuckets = 0; // the index stays empty unless the image checks out
+
+    RankIndexHeader header;
+    if (imageSize < sizeof(header)) {
+        return false;
+    }
+    memcpy(&header, image, sizeof(header));
+    if (memcmp(header.magic, RANK_INDEX_MAGIC, sizeof(header.magic)) != 0) { // not an index, or an older layout
+        return false;
+    }
+
+    size_t wordOffsetsAt = sizeof(RankIndexHeader);
+    size_t bucketStartsAt = wordOffsetsAt + (size_t) header.numWords * sizeof(uint64_t);
+    size_t frequenciesAt = bucketStartsAt + ((size_t) header.numBuckets + 1) * sizeof(uint32_t);
+    size_t poolAt = frequenciesAt + (size_t) header.numWords * sizeof(uint32_t);
+    if (poolAt + header.poolSize != imageSize) { // the file is truncated or has extra bytes
+        return false;
+    }
+
+    bucketStarts = reinterpret_cast<const uint32_t*>(image + bucketStartsAt);
+    wordOffsets = reinterpret_cast<const uint64_t*>(image + wordOffsetsAt);
+    frequencies = reinterpret_cast<const uint32_t*>(image + frequenciesAt);
+    pool = image + poolAt;
+
+    // Every word has to lie inside the pool, so that a damaged file cannot send a query out of bounds
+    if (bucketStarts[0] != 0 || bucketStarts[header.numBuckets] != header.numWords) {
+        return false;
+    }
+    for (uint32_t i = 0; i < header.numBuckets; i++) {
+        if (bucketStarts[i] > bucketStarts[i + 1]) {
+            return false;
+        }
+        for (uint32_t entry = bucketStarts[i]; entry < bucketStarts[i + 1]; entry++) {
+            if (wordOffsets[entry] > header.poolSize || wordOffsets[entry] + i > header.poolSize) {
+                return false;
+            }
+        }
+    }
+
+    numBuckets = header.numBuckets;
+    return true;
+}
+
+// Get the ranked words of the given length
+// Input: length, the length of the words
+// Output: RankedBucket, a view of the words of that length in rank order. It is empty if there are no such words
+RankedBucket RankIndex :: bucket(int length) const {
+    if (length < 0 || length >= (int) numBuckets) { // no words of that length
+        return RankedBucket();
+    }
+    uint32_t first = bucketStarts[length]; // the words of each length are stored together, in rank order
+    return RankedBucket(wordOffsets + first, frequencies + first, pool, length, (int) (bucketStarts[length + 1] - first));
+}
+
+// Find the word of the given length that is ranked rank
+// Input: length, the length of the word. rank, the ranking of the word among words of that length
+// Output: String, the word, or "-" if there is no such word
+string_view RankIndex :: findRank(int length, int rank) const {
+    return bucket(length).findRank(rank);
+}
+
+// Find the word in the bucket that is ranked rank
+// Input: rank, the ranking of the word
+// Output: String, the word, or "-" if the rank is negative or there are not enough words
+string_view RankedBucket :: findRank(int rank) const {
+    if (rank < 0 || rank >= numWords) { // an invalid rank, or not enough words in the bucket
+        return "-";
+    }
+    return word(rank);
+}
+
+// Get a contiguous range of ranks from the bucket, without copying any words
+// Input: rankStart, the ranking of the first word. count, the number of words
+// Output: RankedBucket, the words ranked rankStart up to rankStart + count - 1, cut short at the end of the bucket.
+// It is empty if rankStart is negative or past the end, or count is not positive
+RankedBucket RankedBucket :: slice(int rankStart, int count) const {
+    if (rankStart < 0 || rankStart >= numWords || count <= 0) { // an invalid range, or nothing left in the bucket
+        return RankedBucket();
+    }
+    int sliceSize = min(count, numWords - rankStart);
+    return RankedBucket(wordOffsets + rankStart, frequencies + rankStart, pool, wordLength, sliceSize);
+}
+
+// Prints the bucket in rank order
+// Input: None
+// Output: string that has every word of the bucket in rank order, separated by spaces
+string RankedBucket :: print() const {
+    string bucketStr = ""; // string that will hold the words of the bucket
+    bucketStr.reserve((size_t) numWords * (wordLength + 1));
+    for (RankedBucket::Entry entry : *this) { // loop through the bucket in rank order
+        if (!bucketStr.empty()) {
+            bucketStr += ' ';
+        }
+        bucketStr.append(entry.word);
+    }
+    return bucketStr;
+}
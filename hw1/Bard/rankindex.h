@@ -0,0 +1,107 @@
+// Filename: rankindex.h
+//
+// Header file for the class RankIndex, a compact read-only copy of the ranked word lists that can be
+// saved to a binary file once and memory mapped by every later run of bard, and for the class RankedBucket,
+// a view of the ranked words of a single length inside a RankIndex
+
+#ifndef RANKINDEX_H
+#define RANKINDEX_H
+
+#include "linkedlist.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+// The index is stored as a single image, which is the same in memory and on disk:
+//     header      magic "BARDIDX2", number of buckets, number of words, number of characters in the word pool
+//     uint64_t    wordOffsets[numWords], where each word starts in the pool (its length is the bucket it is in)
+//     uint32_t    bucketStarts[numBuckets + 1], the words of length n are entries bucketStarts[n] up to bucketStarts[n + 1]
+//     uint32_t    frequencies[numWords], how often each word occurs
+//     char        pool[poolSize], the characters of every word, in ranked order
+// Entries within a bucket are in rank order. Integers are stored in the byte order of the machine that built the index.
+// Offsets are 64-bit so that a pool of more than 4 GiB of characters can be indexed; they come right after the 24 byte
+// header to stay aligned
+struct RankIndexHeader {
+    char magic[8];
+    uint32_t numBuckets;
+    uint32_t numWords;
+    uint64_t poolSize;
+};
+
+// The ranked words of one length, frozen into parallel arrays: where each word starts in the pool, and how often it
+// occurs. Entry i is the word ranked i. Each entry takes 12 bytes plus its characters, and a walk through the bucket
+// reads the arrays front to back instead of chasing next pointers. The arrays belong to the RankIndex it came from
+class RankedBucket {
+    private:
+        const uint64_t* wordOffsets; // Where each word starts in the pool
+        const uint32_t* frequencies; // How often each word occurs
+        const char* pool; // The characters of every word
+        int wordLength; // Length of every word in the bucket
+        int numWords; // Number of words in the bucket
+    public:
+        // One word of the bucket, as visited by the iterator
+        struct Entry {
+            string_view word;
+            int frequency;
+        };
+
+        // Visits the words of the bucket in rank order
+        class iterator {
+            private:
+                const RankedBucket* bucket;
+                int rank;
+            public:
+                iterator(const RankedBucket* bucket, int rank) : bucket(bucket), rank(rank) {}
+                Entry operator*() const { return Entry{bucket->word(rank), bucket->frequency(rank)}; }
+                iterator& operator++() { rank++; return *this; }
+                bool operator!=(const iterator& other) const { return rank != other.rank; }
+                bool operator==(const iterator& other) const { return rank == other.rank; }
+        };
+
+        RankedBucket() : wordOffsets(NULL), frequencies(NULL), pool(NULL), wordLength(0), numWords(0) {} // An empty bucket
+        RankedBucket(const uint64_t* wordOffsets, const uint32_t* frequencies, const char* pool, int wordLength, int numWords)
+            : wordOffsets(wordOffsets), frequencies(frequencies), pool(pool), wordLength(wordLength), numWords(numWords) {}
+
+        int size() const { return numWords; } // Number of words in the bucket
+        string_view word(int rank) const { return string_view(pool + wordOffsets[rank], wordLength); } // The word ranked rank, which must be in the bucket
+        int frequency(int rank) const { return (int) frequencies[rank]; } // How often the word ranked rank occurs
+        string_view findRank(int rank) const; // The word ranked rank, or "-" if there is none
+        RankedBucket slice(int rankStart, int count) const; // The count words ranked from rankStart on (fewer if the bucket runs out)
+        string print() const; // Construct string with the words of the bucket in rank order
+        iterator begin() const { return iterator(this, 0); }
+        iterator end() const { return iterator(this, numWords); }
+};
+
+class RankIndex {
+    private:
+        vector<char> storage; // The image, when the index was built in memory
+        const char* mapping; // The image, when the index was mapped from a file (NULL otherwise)
+        size_t mappingSize; // Number of bytes mapped
+        // Views of the arrays inside the image
+        uint32_t numBuckets;
+        const uint32_t* bucketStarts;
+        const uint64_t* wordOffsets;
+        const uint32_t* frequencies;
+        const char* pool;
+
+        bool attach(const char* image, size_t imageSize); // Point the views at an image, after checking that it is valid
+    public:
+        RankIndex(); // Default constructor, the index is empty
+        ~RankIndex(); // Unmaps the index file, if there is one
+        RankIndex(const RankIndex&) = delete; // The views point into storage, so copies would share it
+        RankIndex& operator=(const RankIndex&) = delete;
+
+        void build(vector<WordList>& wordsList); // Copy sorted, frozen lists into the index, where wordsList[n] holds the words of length n
+        bool save(const string& filename) const; // Write the index to a file. Returns false if it cannot be written
+        bool load(const string& filename); // Memory map an index file written by save(). Returns false if it is missing or invalid
+
+        int maxWordLength() const { return (int) numBuckets - 1; } // Length of the longest word
+        RankedBucket bucket(int length) const; // The ranked words of this length (an empty bucket if there are none)
+        string_view findRank(int length, int rank) const; // The word of this length that is ranked rank, or "-" if there is none
+};
+
+#endif
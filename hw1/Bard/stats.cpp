@@ -0,0 +1,185 @@
+// Filename: stats.cpp
+//
+// Contains the instrumentation of bard. Every heap allocation in the process goes through the replacement
+// operators new below (plain, array, nothrow and aligned), which count it before handing it to malloc, once
+// --stats has turned counting on. The
+// counters are atomic, since the corpus is counted and ranked on several threads at once.
+
+#include "stats.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <sys/resource.h>
+using namespace std;
+
+// Heap allocations made so far, and the bytes asked for by them
+atomic<uint64_t> numAllocations(0);
+atomic<uint64_t> numAllocatedBytes(0);
+
+// Whether allocations are counted. It is only set before the worker threads start, so a relaxed load is enough
+atomic<bool> countingAllocations(false);
+
+// Count an allocation (if counting is on), then allocate it the way the default operator new does: with malloc, or
+// posix_memalign for an over-aligned type, calling the new_handler and retrying until it succeeds or there is none.
+// Every form of new below comes here, and every form of delete frees with free, so the two always match
+// Input: size, the number of bytes. alignment, the alignment they need
+// Output: Pointer to the memory. Throws bad_alloc if it cannot be allocated
+void* countedAllocate(size_t size, size_t alignment) {
+    if (countingAllocations.load(memory_order_relaxed)) {
+        numAllocations.fetch_add(1, memory_order_relaxed);
+        numAllocatedBytes.fetch_add(size, memory_order_relaxed);
+    }
+    if (size == 0) { // every allocation has to return a distinct pointer
+        size = 1;
+    }
+    while (true) {
+        void* memory = NULL;
+        if (alignment <= alignof(max_align_t)) {
+            memory = malloc(size);
+        } else if (posix_memalign(&memory, alignment, size) != 0) {
+            memory = NULL;
+        }
+        if (memory != NULL) {
+            return memory;
+        }
+        new_handler handler = get_new_handler();
+        if (handler == NULL) {
+            throw bad_alloc();
+        }
+        handler(); // may free some memory, so try again
+    }
+}
+
+// The same, returning NULL instead of throwing, for the nothrow forms
+void* countedAllocateNoThrow(size_t size, size_t alignment) noexcept {
+    try {
+        return countedAllocate(size, alignment);
+    } catch (...) {
+        return NULL;
+    }
+}
+
+void* operator new(size_t size) { return countedAllocate(size, alignof(max_align_t)); }
+void* operator new[](size_t size) { return countedAllocate(size, alignof(max_align_t)); }
+void* operator new(size_t size, const nothrow_t&) noexcept { return countedAllocateNoThrow(size, alignof(max_align_t)); }
+void* operator new[](size_t size, const nothrow_t&) noexcept { return countedAllocateNoThrow(size, alignof(max_align_t)); }
+void* operator new(size_t size, align_val_t alignment) { return countedAllocate(size, (size_t) alignment); }
+void* operator new[](size_t size, align_val_t alignment) { return countedAllocate(size, (size_t) alignment); }
+void* operator new(size_t size, align_val_t alignment, const nothrow_t&) noexcept { return countedAllocateNoThrow(size, (size_t) alignment); }
+void* operator new[](size_t size, align_val_t alignment, const nothrow_t&) noexcept { return countedAllocateNoThrow(size, (size_t) alignment); }
+
+// Memory from malloc and from posix_memalign is given back with free, whatever form of delete is used
+void operator delete(void* memory) noexcept { free(memory); }
+void operator delete[](void* memory) noexcept { free(memory); }
+void operator delete(void* memory, size_t) noexcept { free(memory); }
+void operator delete[](void* memory, size_t) noexcept { free(memory); }
+void operator delete(void* memory, const nothrow_t&) noexcept { free(memory); }
+void operator delete[](void* memory, const nothrow_t&) noexcept { free(memory); }
+void operator delete(void* memory, align_val_t) noexcept { free(memory); }
+void operator delete[](void* memory, align_val_t) noexcept { free(memory); }
+void operator delete(void* memory, size_t, align_val_t) noexcept { free(memory); }
+void operator delete[](void* memory, size_t, align_val_t) noexcept { free(memory); }
+void operator delete(void* memory, align_val_t, const nothrow_t&) noexcept { free(memory); }
+void operator delete[](void* memory, align_val_t, const nothrow_t&) noexcept { free(memory); }
+
+// Start counting heap allocations
+// Input: None
+// Output: None
+void startCountingAllocations() {
+    countingAllocations.store(true, memory_order_relaxed);
+}
+
+// Number of heap allocations made by the whole process since counting started
+// Input: None
+// Output: uint64_t, the number of calls to any form of operator new
+uint64_t allocationCount() {
+    return numAllocations.load(memory_order_relaxed);
+}
+
+// Number of bytes asked for by the heap allocations so far
+// Input: None
+// Output: uint64_t, the sum of the sizes passed to any form of operator new
+uint64_t allocatedBytes() {
+    return numAllocatedBytes.load(memory_order_relaxed);
+}
+
+// Peak resident set size of the process so far
+// Input: None
+// Output: Long, the peak in kilobytes (0 if it cannot be read)
+long peakMemoryKB() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+    return usage.ru_maxrss; // already in kilobytes on Linux
+}
+
+// Default constructor, no phase is running
+RunStats :: RunStats() {
+    currentName = "";
+    startAllocations = 0;
+    startBytes = 0;
+    mode = "";
+    numThreads = 1;
+}
+
+// End the running phase, if there is one, and start timing a new one
+// Input: name, the name of the new phase
+// Output: None
+void RunStats :: startPhase(const string& name) {
+    endPhase();
+    currentName = name;
+    startAllocations = allocationCount();
+    startBytes = allocatedBytes();
+    currentStart = chrono::steady_clock::now();
+}
+
+// End the running phase, recording its wall time and allocations
+// Input: None
+// Output: None
+void RunStats :: endPhase() {
+    if (currentName.empty()) { // no phase is running
+        return;
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - currentStart;
+    phases.push_back(Phase{currentName, elapsed.count(), allocationCount() - startAllocations, allocatedBytes() - startBytes});
+    currentName = "";
+}
+
+// Record the number of unique words of every length
+// Input: sizes, where sizes[n] is the number of unique words of length n
+// Output: None
+void RunStats :: setBucketSizes(const vector<int>& sizes) {
+    bucketSizes = sizes;
+}
+
+// Write the stats as a single JSON object on one line
+// Input: out, where to write. numLargest, how many of the biggest buckets to list
+// Output: None
+void RunStats :: write(ostream& out, int numLargest) const {
+    out << "{\"mode\": \"" << mode << "\", \"threads\": " << numThreads << ", \"phases\": [";
+    double totalSeconds = 0;
+    for (size_t i = 0; i < phases.size(); i++) { // loop through the phases in order
+        out << (i == 0 ? "" : ", ") << "{\"name\": \"" << phases[i].name << "\", \"seconds\": " << phases[i].seconds
+            << ", \"allocations\": " << phases[i].allocations << ", \"allocated_bytes\": " << phases[i].bytes << "}";
+        totalSeconds += phases[i].seconds;
+    }
+    out << "], \"total_seconds\": " << totalSeconds;
+
+    // The biggest buckets first, and the shorter length first among buckets of the same size
+    vector<int> lengths(bucketSizes.size());
+    for (size_t i = 0; i < lengths.size(); i++) {
+        lengths[i] = i;
+    }
+    stable_sort(lengths.begin(), lengths.end(), [&](int left, int right) {
+        return bucketSizes[left] > bucketSizes[right];
+    });
+    lengths.resize(min((int) lengths.size(), max(numLargest, 0)));
+    out << ", \"largest_buckets\": [";
+    for (size_t i = 0; i < lengths.size(); i++) {
+        out << (i == 0 ? "" : ", ") << "{\"length\": " << lengths[i] << ", \"words\": " << bucketSizes[lengths[i]] << "}";
+    }
+    out << "], \"total_allocations\": " << allocationCount() << ", \"peak_rss_kb\": " << peakMemoryKB() << "}" << endl;
+}
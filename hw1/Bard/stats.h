@@ -0,0 +1,57 @@
+// Filename: stats.h
+//
+// Header file for the instrumentation of bard: the wall time and heap allocations of every phase of a run,
+// the biggest word lists, and the peak memory use of the process, reported as one JSON object
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Start counting heap allocations. Until this is called (by --stats), operator new counts nothing, so a run without
+// --stats pays only for one untaken branch per allocation. Call it before any worker thread is started
+void startCountingAllocations();
+
+// Number of heap allocations made by the whole process since counting started (counted by every global operator new and new[])
+uint64_t allocationCount();
+
+// Number of bytes asked for by those allocations
+uint64_t allocatedBytes();
+
+// Peak resident set size of the process so far, in kilobytes
+long peakMemoryKB();
+
+// Records the phases of one run of bard. Phases run one after another; starting a phase ends the one before it
+class RunStats {
+    private:
+        // A finished phase
+        struct Phase {
+            string name;
+            double seconds; // Wall time
+            uint64_t allocations; // Heap allocations made during the phase
+            uint64_t bytes; // Bytes asked for by those allocations
+        };
+        vector<Phase> phases; // Every finished phase, in order
+        string currentName; // The phase that is running ("" if there is none)
+        chrono::steady_clock::time_point currentStart; // When it started
+        uint64_t startAllocations; // allocationCount() when it started
+        uint64_t startBytes; // allocatedBytes() when it started
+        vector<int> bucketSizes; // bucketSizes[n] is the number of unique words of length n
+    public:
+        string mode; // What the run did: "query", "build-index" or "incremental"
+        int numThreads; // Number of worker threads
+
+        RunStats(); // Default constructor, no phase is running
+        void startPhase(const string& name); // End the running phase, if there is one, and start timing name
+        void endPhase(); // End the running phase
+        void setBucketSizes(const vector<int>& sizes); // Record the number of unique words of every length
+        void write(ostream& out, int numLargest = 5) const; // Write the stats as JSON, with the numLargest biggest buckets
+};
+
+#endif
@@ -0,0 +1,52 @@
+// Filename: wordpool.cpp
+//
+// Contains the class WordPool, which copies the characters of words into large blocks. Words are never
+// moved once they are interned, so views of them stay valid as the pool grows.
+
+#include "wordpool.h"
+#include <algorithm>
+#include <cstring>
+using namespace std;
+
+// Smallest number of characters in a block
+const size_t MIN_BLOCK_SIZE = 4096;
+
+// Default constructor, no block is allocated until the first word is interned
+WordPool :: WordPool() {
+    blockSize = 0;
+    used = 0;
+    totalSize = 0;
+}
+
+// Make sure that the next count characters interned fit in a single block
+// Input: count, the number of characters about to be interned
+// Output: None
+void WordPool :: reserve(size_t count) {
+    if (blockSize - used >= count) { // the newest block already has room
+        return;
+    }
+    blockSize = max(count, MIN_BLOCK_SIZE); // start a block big enough for all of them
+    blocks.push_back(unique_ptr<char[]>(new char[blockSize]));
+    used = 0;
+}
+
+// Copy word into the pool
+// Input: word, the characters to copy
+// Output: A view of the copy, valid for as long as the pool exists
+string_view WordPool :: intern(string_view word) {
+    if (blockSize - used < word.size()) { // the newest block is full, so start a block twice the size
+        size_t newBlockSize = max(2 * blockSize, MIN_BLOCK_SIZE);
+        blockSize = max(newBlockSize, word.size());
+        blocks.push_back(unique_ptr<char[]>(new char[blockSize]));
+        used = 0;
+    }
+
+    char* copy = blocks.empty() ? NULL : blocks.back().get() + used; // where the word goes (empty words need no block)
+    if (word.size() > 0) {
+        memcpy(copy, word.data(), word.size());
+    }
+    used += word.size();
+    totalSize += word.size();
+
+    return string_view(copy, word.size());
+}
@@ -0,0 +1,33 @@
+// Filename: wordpool.h
+//
+// Header file for the class WordPool, which stores the characters of every unique word once
+
+#ifndef WORDPOOL_H
+#define WORDPOOL_H
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+// Interns words into large blocks of characters. The string_view returned for a word stays valid for as long
+// as the pool exists, so Nodes can point at their word instead of owning a copy of it
+class WordPool {
+    private:
+        vector<unique_ptr<char[]>> blocks; // Every block of characters allocated so far
+        size_t blockSize; // Number of characters in the newest block
+        size_t used; // Number of characters in use in the newest block
+        size_t totalSize; // Number of characters interned over all blocks
+    public:
+        WordPool(); // Default constructor, no block is allocated until the first word is interned
+        WordPool(const WordPool&) = delete; // Views into the blocks would be shared by both copies
+        WordPool& operator=(const WordPool&) = delete;
+
+        void reserve(size_t); // Make sure the next block can hold this many characters, so they stay contiguous
+        string_view intern(string_view); // Copy the word into the pool, and return a view of the copy
+        size_t size() const { return totalSize; } // Number of characters interned
+};
+
+#endif
@@ -16,6 +16,7 @@
 #include <vector>
 #include <algorithm>
 #include <sstream>
+#include "trace.h"
 using namespace std;
 
 // Class used to store information about a Queen on a chessboard
@@ -29,29 +30,34 @@ class Queen {
 //     Queen(int col, int row) : col(col), row(row) {}
 };
 
-void printChessboard(vector<vector<int>> chessboard) {
+// Print out the chessboard to the debug trace, one row per line from the top row down
+// Input: chessboard, the board to print (by reference, so it is not copied for every print)
+// Output: None
+void printChessboard(const vector<vector<int>>& chessboard) {
+    if (!TRACE_ENABLED(TRACE_DEBUG)) { // nothing to do unless debug tracing is on
+        return;
+    }
     // Print out chessboard
-	cout << "Chessboard: " << endl;
+	TRACE(TRACE_DEBUG, "Chessboard: ");
 	int cols = chessboard.size();
 	for (int i = cols - 1; i > 0; i--) {
 		int rows = chessboard[0].size();
         if (i != cols) {
             if (i >= 10) {
-                cout << "Row " << i << ":";
+                TRACE_PART(TRACE_DEBUG, "Row ", i, ":");
             } 
             else {
-                cout << "Row  " << i << ":";
+                TRACE_PART(TRACE_DEBUG, "Row  ", i, ":");
             }                    
         }
         for (int j = 1; j < rows; j++) {
-//         cout << "{" << i << ", " << j << "}" << endl;
             if (chessboard[i][j] < 0) {
-                cout << " " << chessboard [i][j] << "";
+                TRACE_PART(TRACE_DEBUG, " ", chessboard[i][j]);
             } else {
-                cout << "  " << chessboard[i][j];
+                TRACE_PART(TRACE_DEBUG, "  ", chessboard[i][j]);
                 }
         }
-	cout << "\n";
+	TRACE(TRACE_DEBUG, "");
 	}
 }
 
@@ -72,7 +78,6 @@ bool getSolutionsStk(vector<vector<int>> &board, vector<class Queen> &nqueens, i
         
         printChessboard(stacktop.chessboard);
         
-        bool queenInEveryRow = false;
         int queenCounter = 0;
         int rowCounter = 1;
         
@@ -88,16 +93,16 @@ bool getSolutionsStk(vector<vector<int>> &board, vector<class Queen> &nqueens, i
             
             rowCounter++;
         }
-        cout << queenCounter << endl;
-        cout << boardDim - 1 << endl;
-        cout << stacktop.row << endl;
+        TRACE(TRACE_DEBUG, queenCounter);
+        TRACE(TRACE_DEBUG, boardDim - 1);
+        TRACE(TRACE_DEBUG, stacktop.row);
         if (nqueens == (boardDim - 1)) {
             return true; // NEED TO CHANGE RETURN TYPE
             break;
         }
         else if (stacktop.row == (boardDim - 1))'
             ' { // backtrack
-            cout << "BACKTRACK" << endl;
+            TRACE(TRACE_DEBUG, "BACKTRACK");
             Queen tempQueen;
 // n queen
             tempQueen.chessboard = stacktop.chessboard; // restore previous board
@@ -426,7 +431,7 @@ int main(int argc, char** argv) {
 // 				cout << "Cols No solution" << endl;
 				// Continue to next line in input
 			} else {
-				cout << "Cols pass" << endl;
+				TRACE(TRACE_DEBUG, "Cols pass");
 			}
 			
 			// Check that queens are on their own unique row
@@ -439,7 +444,7 @@ int main(int argc, char** argv) {
 // 				cout << "Row No Solution" << endl;
 				// Continue to next line in input
 			} else {
-				cout << "Rows pass" << endl;
+				TRACE(TRACE_DEBUG, "Rows pass");
 			}
 		} 
 		
@@ -495,7 +500,7 @@ int main(int argc, char** argv) {
             break;
         }
         
-        cout << "Initial Board: " << endl;
+        TRACE(TRACE_DEBUG, "Initial Board: ");
         printChessboard(chessboard);
         // 		if (!getSolutions(chessboard, nqueens, chessboardDim, 1)) {
 
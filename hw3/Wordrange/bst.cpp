@@ -16,6 +16,7 @@
 #include <algorithm>
 #include <string>
 #include <stack>
+#include "trace.h"
 using namespace std;
 
 // Default constructor sets head and tail to NULL
@@ -344,11 +345,14 @@ string BST::printPostOrder(Node* start) {
 
 /**
  * printTree()
- * Print out a visualization of the tree.
+ * Print out a visualization of the tree to the debug trace (see trace.h).
  * Input: none
  * Output: none
  */
 void BST::printTree() {
+    if (!TRACE_ENABLED(TRACE_DEBUG)) { // the tree is only printed to the debug trace
+        return;
+    }
     printTree("", root, false);
 }
 
@@ -364,7 +368,7 @@ void BST::printTree(string prefix, Node* start, bool isLeft) {
         // Determine proper indent identifier
         string indent = (isLeft) ? "|--" : "\\--";
         // Output string
-        cout << prefix << indent << start->key << endl;
+        TRACE(TRACE_DEBUG, prefix, indent, start->key);
         // Determine next output indentation
         indent = (isLeft) ? "|   " : "    ";
         prefix += indent;
@@ -19,7 +19,9 @@
 #include <fstream>
 #include <sstream>
 #include "bst.h"
-#include <cstring>
+#include "scanner.h"
+#include <string>
+#include <string_view>
 using namespace std;
 
 int main(int argc, char** argv) {
@@ -30,43 +32,37 @@ int main(int argc, char** argv) {
     /**
      * Input/output processing code
      */
-    ifstream input; // Initialize stream for input file
     ofstream output; // Initiailize stream for output file
     
-    input.open(argv[1]); // Open input file
+    // Read the whole input file, so its lines and tokens can be scanned in place
+    string inputText = "";
+    readFile(argv[1], inputText); // Open input file
     output.open(argv[2]); // Open output file
     
-    string command = ""; // Store the next command and operator
-    char *com, *valstr, *op; // For use with strtok, strtol
+    string_view command; // Store the next command and operator
+    string_view op, valstr; // Tokens of the command
     string val1 = ""; // First value from the command
     string val2 = ""; // Optional second value if performing range queries
     
     BST myBST; // initializing the linked list
     
     // Loop through input file
-    while(getline(input, command)) {
-        if (command.length() == 0) // command is empty
+    LineScanner lines(inputText);
+    while(lines.next(command)) {
+        TokenScanner tokens(command); // Tokenize command on whitepsace
+        if (!tokens.next(op)) // command is empty, first token is operation
             continue;
         
-        com = strdup(command.c_str()); // First copy string into a "C-style" string
-        op = strtok(com, " \t"); // Tokenize command on whitepsace, first token is operation
-        
-        valstr = strtok(NULL, " \t"); // Next token is value, as string
-        if (valstr != NULL) { // Check if an argument was passed
-            // Convert initial portion of valstr into a string
-            string temp1(valstr);
-            val1 = temp1;
+        if (tokens.next(valstr)) { // Next token is value, check if an argument was passed
+            val1 = string(valstr);
         }
         
-        valstr = strtok(NULL, " \t"); // Final token is the optional second value
-        if (valstr != NULL) { // Check if an argument was passed
-            // Convert initial portion of valstr into a string
-            string temp2(valstr);
-            val2 = temp2;
+        if (tokens.next(valstr)) { // Final token is the optional second value, check if an argument was passed
+            val2 = string(valstr);
         }
         
         // Insert val1 into BST
-        if(strcmp(op, "i") == 0) {
+        if(op == "i") {
             // First determine if val1 is in the BST. If it isn't, insert
             // val1 into the tree
             if (myBST.find(val1) == NULL) {
@@ -76,7 +72,7 @@ int main(int argc, char** argv) {
         
         // Count the number of strings (currently stored) that are
         // lexicographically between val1 and val2
-        if (strcmp(op, "r") == 0) {
+        if (op == "r") {
             // Initailize var that stores the number of strings between
             // val1 and val2
             int rangeSize = 0;
@@ -85,17 +81,13 @@ int main(int argc, char** argv) {
             rangeSize = myBST.numItemsInRange(val1, val2);
             
             // Write rangeSize back to output file
-            output << rangeSize << endl;
+            output << rangeSize << "\n";
         }
-        
-        // Free allocated memory from strdup
-        free(com);
     }
         
     myBST.deleteBST(); // Delete the tree from memory
     
-    // Close input/output streams
-    input.close();
+    // Close output stream
     output.close();
     
     return 0;
@@ -29,6 +29,8 @@
 #include <tuple>
 #include <set>
 #include <unordered_map>
+#include <string_view>
+#include "scanner.h"
 using namespace std;
 
 
@@ -168,7 +170,6 @@ int main(int argc, char** argv) {
         throw std::invalid_argument("Usage: ./sixdegrees <INPUT FILE> <OUTPUT FILE>"); // throw error
     }
     
-    ifstream input; // stream for input file
     ofstream output; // stream for output file
     
     // Initialize a list to store a list of Movie's (each object will
@@ -183,26 +184,27 @@ int main(int argc, char** argv) {
      * Parse through cleaned_movielist and create a map of sets. The key will be
      * a movie, and its value will be a set of actors
      */
-    ifstream imdbStream("cleaned_movielist.txt"); // stream of IMDB data
-    string line = ""; // store the text in the current line
+    string imdbText = ""; // contents of the IMDB data
+    readFile("cleaned_movielist.txt", imdbText);
+    string_view line; // store the text in the current line
     // Iterate through each line of claned_movielist.txt
-    while(getline(imdbStream, line)) {
-        istringstream ss(line); // initialize istringstream obj for parsing
+    LineScanner imdbLines(imdbText);
+    while(imdbLines.next(line)) {
+        TokenScanner words(line); // scanner for the words of the line
         int movieCounter = 0; // track the location of the movie in the line
-        string movie = ""; // store the movie of the current line
-        string word = ""; // store the string val
+        string_view word; // store the string val
         
         // Initailize a Movie object to store a movie title and its actors
         Movie tempMov;
-        while(getline(ss, word, ' ')) {
+        while(words.next(word)) {
             // Insert the movie into movieMap
             if (movieCounter == 0) {
-                tempMov.setMovieTitle(word);
+                tempMov.setMovieTitle(string(word));
                 // Movie has been added, so increment counter to parse actors
                 movieCounter++;
             } else {
                 // Insert the actor into the specified movie
-                tempMov.insertActor(word);
+                tempMov.insertActor(string(word));
             }
         }
         
@@ -252,14 +254,17 @@ int main(int argc, char** argv) {
     /**
      * Parse input files and write the shortest path (if there is one) to the output file
      */
-    input.open(argv[1]); // open input file
+    string inputText = ""; // contents of the input file
+    readFile(argv[1], inputText); // open input file
     output.open(argv[2]); // open output file
     
     // Parse through input file and look for the shortest path between the
     // two actors
-    string actor1 = ""; 
-    string actor2 = "";
-    while (input >> actor1 >> actor2) {   
+    TokenScanner inputTokens(inputText);
+    string_view actor1Token, actor2Token;
+    while (inputTokens.next(actor1Token) && inputTokens.next(actor2Token)) {   
+        string actor1(actor1Token);
+        string actor2(actor2Token);
         // Determine if actor1 and actor2 are present in the data
         if (actorGraph.find(actor1) == actorGraph.end() 
             || actorGraph.find(actor2) == actorGraph.end()) {
@@ -335,7 +340,6 @@ int main(int argc, char** argv) {
         output << endl;
     }
     
-    input.close(); // close input stream
     output.close(); // close output stream
     
     return 0;
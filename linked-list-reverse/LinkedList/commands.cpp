@@ -0,0 +1,126 @@
+// Filename: commands.cpp
+//
+// Contains the command reader of listwrapper. Lines are found and split into tokens with the shared scanner,
+// directly in the block that was read from the file.
+
+#include "commands.h"
+#include "scanner.h"
+using namespace std;
+
+// Number of bytes read from the file at a time
+const size_t COMMAND_BLOCK_SIZE = 1 << 20;
+// Largest number of commands handed out by one call to nextBatch
+const size_t COMMAND_BATCH_SIZE = 4096;
+
+// Convert the initial portion of str into an integer, the same way strtol(str, &end, 10) does: an optional sign
+// followed by digits, stopping at the first other character. A token that does not start with a number gives 0.
+// Input: str, the token to convert
+// Output: Int, the value of the token
+int parseValue(string_view str)
+{
+    size_t i = 0;
+    bool negative = false;
+    if (i < str.size() && (str[i] == '+' || str[i] == '-'))
+    {
+        negative = (str[i] == '-');
+        i++;
+    }
+    long long value = 0;
+    for (; i < str.size() && str[i] >= '0' && str[i] <= '9'; i++)
+    {
+        if (value <= 4000000000LL) // past INT_MAX already, so stop growing (strtol saturates too)
+            value = value * 10 + (str[i] - '0');
+    }
+    return (int) (negative ? -value : value);
+}
+
+// Default constructor, nothing is read until open() is called
+CommandReader :: CommandReader()
+{
+    pos = 0;
+    atEnd = true;
+    value = 0;
+}
+
+// Open the log for reading
+// Input: filename, the log to read
+// Output: Bool, whether the file could be opened
+bool CommandReader :: open(const string& filename)
+{
+    file.open(filename, ios::binary);
+    block.clear();
+    pos = 0;
+    atEnd = !file;
+    value = 0;
+    return (bool) file;
+}
+
+// Move the part of block that has not been decoded to the front, and read the next block of the file after it
+// Input: None
+// Output: Bool, whether anything was read
+bool CommandReader :: refill()
+{
+    block.erase(0, pos); // only the start of an unfinished line is left, so this moves very little
+    pos = 0;
+    size_t kept = block.size();
+    block.resize(kept + COMMAND_BLOCK_SIZE);
+    file.read(&block[kept], COMMAND_BLOCK_SIZE);
+    block.resize(kept + file.gcount());
+    if (file.gcount() == 0) // nothing left in the file
+        atEnd = true;
+    return !atEnd;
+}
+
+// Decode one line of the log, the same way the listwrapper loop always has: the first token is the operation,
+// and the second token (if there is one) is the value. Lines with an unknown operation add no command.
+// Input: line, the line without its '\n'. batch, where the command is appended
+// Output: None
+void CommandReader :: decodeLine(string_view line, vector<Command>& batch)
+{
+    string_view op, valstr; // the tokens of the command
+    TokenScanner tokens(line); // tokenize command on whitespace, first token is operation
+    if (!tokens.next(op)) // command is empty
+        return;
+
+    if (op == "p") // print list, which takes no value
+    {
+        batch.push_back({PRINT, 0});
+        return;
+    }
+
+    if (tokens.next(valstr)) // next token is value, first check if there is actually anything to convert into int
+        value = parseValue(valstr);
+
+    if (op == "i")
+        batch.push_back({INSERT, value});
+    else if (op == "d")
+        batch.push_back({DELETE, value});
+    else if (op == "rev")
+        batch.push_back({REVERSE, value});
+    else if (op == "revk")
+        batch.push_back({REVERSE_GROUPS, value});
+}
+
+// Decode the next commands of the log, reading more of the file as needed
+// Input: batch, replaced by up to COMMAND_BATCH_SIZE commands, in order
+// Output: Bool, whether any command was decoded (false once the log is finished)
+bool CommandReader :: nextBatch(vector<Command>& batch)
+{
+    batch.clear();
+    while (batch.size() < COMMAND_BATCH_SIZE)
+    {
+        if (pos == block.size() && (atEnd || !refill())) // every byte of the file has been decoded
+            break;
+        const char* text = block.data();
+        const char* end = text + block.size();
+        const char* lineEnd = findByte(text + pos, end, '\n');
+        if (lineEnd == end && !atEnd) // the line continues in the next block
+        {
+            refill();
+            continue;
+        }
+        decodeLine(string_view(text + pos, lineEnd - (text + pos)), batch);
+        pos = (lineEnd - text) + (lineEnd != end); // move past the '\n' (to the end for a final line without one)
+    }
+    return !batch.empty();
+}
@@ -0,0 +1,45 @@
+// Filename: commands.h
+//
+// Header file for the command reader of listwrapper. The operation log is read in large blocks, and every
+// line is decoded in place into a Command, so no line is copied. Commands are handed out in batches.
+
+#ifndef COMMANDS_H
+#define COMMANDS_H
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+// The operations of the log: "i <INT>", "d <INT>", "p", "rev <INT>" and "revk <INT>"
+enum CommandType { INSERT, DELETE, PRINT, REVERSE, REVERSE_GROUPS };
+
+// A decoded line of the log
+struct Command {
+    CommandType type;
+    int value; // The INT argument (unused for PRINT)
+};
+
+// Convert the initial portion of str into an integer, the same way strtol(str, &end, 10) does
+int parseValue(string_view str);
+
+// Reads the commands of an operation log, one block of the file at a time
+class CommandReader {
+    private:
+        ifstream file; // The log
+        string block; // Bytes read from the file that have not been decoded yet start at block[pos]
+        size_t pos; // Start of the next line in block
+        bool atEnd; // Whether the whole file has been read into block
+        int value; // The last INT argument seen. A line without one reuses it, like the original strtok loop
+        bool refill(); // Drop the decoded part of block and read the next block of the file after the rest
+        void decodeLine(string_view line, vector<Command>& batch); // Append the command on line (if any) to batch
+    public:
+        CommandReader(); // Default constructor, open() must be called before reading
+        bool open(const string& filename); // Open the log. Returns false if it cannot be opened
+        bool nextBatch(vector<Command>& batch); // Replace batch with the next commands. Returns false once there are none left
+};
+
+#endif
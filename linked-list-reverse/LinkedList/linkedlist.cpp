@@ -1,47 +1,227 @@
 // Filename: linkedlist.cpp
 // 
 // Contains the class LinkedList that represents a linked list. This contains some basic operations, such as insert, delete, find, length
+// The list is unrolled, so every Node holds a run of up to NODE_CAPACITY ints (see linkedlist.h)
 // 
 // Japheth Frolick, August 2019
 // C. Seshadhri, Jan 2020
 
 #include "linkedlist.h"
+#include "writer.h"
 #include <cstdlib>
 #include <iostream>
 #include <vector> 
 #include <algorithm>
 #include <string>
+#include <cstring>
+#include <charconv>
 using namespace std;
 
 // Default constructor sets head and tail to null
 LinkedList :: LinkedList()
 {
 	head = NULL;
+    size = 0;
+    indexed = false;
+    labelEpoch = 0;
+}
+
+// newNode(): Take storage for one Node from the pool. The caller sets every field it uses
+// Input: None
+// Output: Pointer to the new Node
+Node* LinkedList :: newNode()
+{
+    return static_cast<Node*>(pool.allocate(sizeof(Node)));
+}
+
+// freeNode(Node* node): Give node back to the pool, which hands it out again on the next newNode
+// Input: Node that is no longer in the list
+// Output: None
+void LinkedList :: freeNode(Node* node)
+{
+    pool.deallocate(node);
+}
+
+// buildIndex(): Build a hash map from every value to the Nodes holding it. From then on insert, deleteNode, deleteList and the
+// reverse functions keep the map up to date, and find and deleteNode look values up in it instead of scanning the list.
+// The index counts the copies of a value per Node rather than keeping one entry per copy, so moving or removing a copy
+// takes O(1) expected time however many copies there are. The Node that comes first is cached. It is kept up to date as
+// copies move, and a reverse recomputes it for the values of the reversed Nodes only. It is found again by comparing the
+// labels of the Nodes holding the value only after relabel(), or when the first Node loses its last copy and the next
+// Node holding the value is not close behind it.
+// Input: None
+// Output: Void, just builds the index
+void LinkedList :: buildIndex()
+{
+    indexed = true;
+    index.clear();
+    index.reserve(size);
+    for (Node *curr = head; curr != NULL; curr = curr->next) // looping over list
+    {
+        for (int i = curr->begin; i < curr->end; i++)
+        {
+            IndexEntry &entry = index[curr->data[i]];
+            if (entry.counts[curr]++ == 0 && entry.first == NULL) // the list is walked in order, so the first Node seen comes first
+            {
+                entry.first = curr;
+                entry.firstEpoch = labelEpoch;
+            }
+        }
+    }
+}
+
+// relabel(): Give the Nodes the labels 0, LABEL_GAP, 2*LABEL_GAP, ... in list order. This is needed when a Node has to be
+// placed between two Nodes whose labels are adjacent, which happens rarely.
+// Input: None
+// Output: Void, just relabels the Nodes
+void LinkedList :: relabel()
+{
+    long long label = 0;
+    for (Node *curr = head; curr != NULL; curr = curr->next) { // looping over list
+        curr->label = label;
+        label += LABEL_GAP;
+    }
+    labelEpoch++;
+}
+
+// indexMove(int val, Node* from, Node* to): Update the index after a copy of val moved from the Node from to the Node to
+// Input: the value that moved, the Node it was in, and the Node it is in now
+// Output: Void, just updates the index
+void LinkedList :: indexMove(int val, Node* from, Node* to)
+{
+    if (!indexed || from == to)
+        return;
+    IndexEntry &entry = index[val];
+    entry.counts[to]++;
+    bool firstKnown = entry.first != NULL && entry.firstEpoch == labelEpoch;
+    if (firstKnown && to->label < entry.first->label) // to comes before the cached first
+        entry.first = to;
+    auto fromCount = entry.counts.find(from);
+    if (--fromCount->second == 0) // from holds no more copies of val
+    {
+        entry.counts.erase(fromCount);
+        if (entry.first == from)
+            entry.first = firstKnown ? indexFirstAfter(entry, from) : NULL;
+    }
+}
+
+// indexFirstAfter(IndexEntry& entry, Node* node): Find the Node holding the value of entry that comes first, given that
+// node just lost its last copy of it and no Node before node holds it. Only as many Nodes as there are in entry.counts
+// are walked, so this is never slower than comparing their labels; when that is not enough, the first is left unknown.
+// Input: the index entry of the value, and the Node that used to come first
+// Output: the Node that comes first now, or NULL if it has to be found again later
+Node* LinkedList :: indexFirstAfter(IndexEntry& entry, Node* node)
+{
+    size_t steps = 0;
+    for (Node *curr = node->next; curr != NULL && steps < entry.counts.size(); curr = curr->next, steps++)
+        if (entry.counts.count(curr) != 0)
+            return curr;
+    return NULL;
+}
+
+// indexReversed(Node* start): Update the cached first Nodes after the Nodes from start were reversed. Those Nodes come
+// before every other Node holding their values, so only the values they hold can have a new first, and it is the first of
+// them (in the new order) that holds the value. The Nodes are walked twice: once to forget the old first of every value
+// they hold, and once to set the new one.
+// Input: the head of the reversed Nodes, which run up to a NULL next
+// Output: Void, just updates the index
+void LinkedList :: indexReversed(Node* start)
+{
+    if (!indexed)
+        return;
+    for (Node *curr = start; curr != NULL; curr = curr->next)
+        for (int i = curr->begin; i < curr->end; i++)
+            index[curr->data[i]].first = NULL;
+    for (Node *curr = start; curr != NULL; curr = curr->next)
+        for (int i = curr->begin; i < curr->end; i++)
+        {
+            IndexEntry &entry = index[curr->data[i]];
+            if (entry.first == NULL)
+            {
+                entry.first = curr;
+                entry.firstEpoch = labelEpoch;
+            }
+        }
+}
+
+// indexRemove(int val, Node* node): Update the index after a copy of val was removed from node
+// Input: the value that was removed, and the Node it was in
+// Output: Void, just updates the index
+void LinkedList :: indexRemove(int val, Node* node)
+{
+    if (!indexed)
+        return;
+    auto entry = index.find(val);
+    auto count = entry->second.counts.find(node);
+    if (--count->second == 0) // node holds no more copies of val
+    {
+        entry->second.counts.erase(count);
+        if (entry->second.counts.empty()) // no copies of val are left
+            index.erase(entry);
+        else if (entry->second.first == node)
+            entry->second.first = (entry->second.firstEpoch == labelEpoch) ? indexFirstAfter(entry->second, node) : NULL;
+    }
 }
 
 // Insert(int val): Inserts the int val into list, at the head of the list. Note that there may be multiple copies of val in the list.
 // Input: Int to insert into the linked list
-// Output: Void, just inserts new Node
+// Output: Void, just inserts val, in a new Node only if the head Node has no free slot at its front
 void LinkedList :: insert(int val)
 {
-	Node *to_add = new Node; // creates new Node
-	to_add->data = val; // sets the data to hold input val
-	
-    to_add->next = head; // make to_add point to existing head
-    head = to_add; // set head to to_add
+    size++;
+    if (head == NULL || head->begin == 0) // the head Node has no room in front of its first int, so add a new head Node
+    {
+        Node *to_add = newNode(); // creates new Node
+        to_add->begin = NODE_CAPACITY; // the Node is empty, with every slot free for inserts
+        to_add->end = NODE_CAPACITY;
+        to_add->label = (head != NULL) ? head->label - LABEL_GAP : 0; // to_add comes before the existing head
+
+        to_add->next = head; // make to_add point to existing head
+        to_add->prev = NULL;
+        if (head != NULL)
+            head->prev = to_add;
+        head = to_add; // set head to to_add
+    }
+    head->begin--;
+    head->data[head->begin] = val; // val is now the first int of the list
+    if (indexed)
+    {
+        IndexEntry &entry = index[val];
+        entry.counts[head]++;
+        entry.first = head; // nothing comes before the head Node
+        entry.firstEpoch = labelEpoch;
+    }
 }
 
-// find(int val): Finds a Node with data "val"
+// find(int val): Finds a Node holding "val"
 // Input: int to be found
 // Output: a pointer to a Node containing val, if it exists. Otherwise, it returns NULL
 // Technically, it finds the first Node in the list containing val
 Node* LinkedList :: find(int val)
 {
+    if (indexed) // look val up in the index, and return the first of the Nodes holding it
+    {
+        auto found = index.find(val);
+        if (found == index.end()) // val not found
+            return NULL;
+        IndexEntry &entry = found->second;
+        if (entry.first == NULL || entry.firstEpoch != labelEpoch) // the cached first is stale, so compare the labels again
+        {
+            entry.first = NULL;
+            for (auto &count : entry.counts)
+                if (entry.first == NULL || count.first->label < entry.first->label)
+                    entry.first = count.first;
+            entry.firstEpoch = labelEpoch;
+        }
+        return entry.first;
+    }
+
     Node *curr = head; // curr is the current Node as it progresses through the linked list. Initialized to head to start at the head of the list
-    // curr will look over list. At every iteration, we will check if curr->data is val. If so, we are done. Otherwise, we proceed through the list.
+    // curr will look over list. At every iteration, we will check if the ints of curr contain val. If so, we are done. Otherwise, we proceed through the list.
     while(curr != NULL) //looping over list
     {
-        if (curr->data == val) // found val, so return curr
+        int *last = curr->data + curr->end;
+        if (std::find(curr->data + curr->begin, last, val) != last) // found val, so return curr
             return curr;
         curr = curr->next; // otherwise, proceed through list
     }
@@ -49,48 +229,91 @@ Node* LinkedList :: find(int val)
     return NULL;
 }
 
-// deleteNode(int val): Delete a Node with data val, if it exists. Otherwise, do nothing.
+// mergeNext(Node* node): If the ints of the Node after node fit into the free slots of node, move them there and delete that Node.
+// The ints of node are moved to the back of its array, so its free slots stay in front.
+// Input: Node whose successor should be merged into it
+// Output: Bool, whether the two Nodes were merged
+bool LinkedList :: mergeNext(Node* node)
+{
+    Node *after = node->next;
+    if (after == NULL)
+        return false;
+    int nodeSize = node->end - node->begin;
+    int afterSize = after->end - after->begin;
+    if (nodeSize + afterSize > NODE_CAPACITY) // they do not fit in one Node
+        return false;
+
+    int newBegin = NODE_CAPACITY - nodeSize - afterSize;
+    memmove(node->data + newBegin, node->data + node->begin, nodeSize * sizeof(int)); // ints of node go first
+    memcpy(node->data + newBegin + nodeSize, after->data + after->begin, afterSize * sizeof(int)); // followed by the ints of after
+    node->begin = newBegin;
+    node->end = NODE_CAPACITY;
+
+    for (int i = node->end - afterSize; i < node->end; i++) // the moved ints are now held by node
+        indexMove(node->data[i], after, node);
+
+    node->next = after->next; // remove after from the list
+    if (after->next != NULL)
+        after->next->prev = node;
+    freeNode(after);
+    return true;
+}
+
+// deleteNode(int val): Delete an int val, if it exists. Otherwise, do nothing.
 // Input: int to be removed
-// Output: pointer to Node that was deleted. If no Node is deleted, return NULL. If there are multiple Nodes with val, only the first Node in the list is deleted.
-Node* LinkedList :: deleteNode(int val)
+// Output: Bool, whether val was removed. If there are multiple copies of val, only the first one in the list is deleted.
+// A Node that becomes empty is deleted, and a Node that becomes less than half full is merged with a neighbor when they fit together.
+// With an index, the Node holding val is found without scanning the list, and its prev link gives the Node before it.
+bool LinkedList :: deleteNode(int val)
 {
-    Node* prev = NULL;
-    Node* curr = head;
-    while(curr != NULL) // loop over list, starting from head
+    Node* curr = find(val); // the first Node holding val. If curr is null, then val is not in the list.
+    if (curr == NULL) // val not found
+        return false;
+    Node* prev = curr->prev;
+    int *pos = std::find(curr->data + curr->begin, curr->data + curr->end, val); // position of val in curr->data
+
+    size--;
+    indexRemove(val, curr);
+    // remove val from curr by shifting whichever side of it is shorter
+    int index = pos - curr->data;
+    if (index - curr->begin < curr->end - 1 - index) // fewer ints before val, so shift them back by one
     {
-        if(curr->data == val) // we found Node with val, so break
-            break; 
-        //otherwise, proceed list
-        prev = curr; // move prev by one Node
-        curr = curr->next; // move curr by one Node
+        memmove(curr->data + curr->begin + 1, curr->data + curr->begin, (index - curr->begin) * sizeof(int));
+        curr->begin++;
     }
-    // at this point, curr points to Node with val. If curr is null, then val is not in the list.
-    if (curr == NULL) // val not found
-        return NULL; 
-    // val is in list. Note that curr is not NULL. There is a case analysis now. If prev is null, then curr is head. So we delete head directly.
-    // Otherwise, we delete the Node after prev.
-    if (prev == NULL) // we need to delete head
-        head = head->next; // delete head
-    else // we delete Node after prev. Note that both curr and prev are not NULL
-        prev->next = curr->next; // make prev point to Node after curr. This removes curr from list
-    return curr;
+    else // fewer ints after val, so shift them forward by one
+    {
+        memmove(curr->data + index, curr->data + index + 1, (curr->end - 1 - index) * sizeof(int));
+        curr->end--;
+    }
+
+    if (curr->begin == curr->end) // curr is now empty, so remove it from the list. If prev is null, then curr is head.
+    {
+        if (prev == NULL) // we need to delete head
+            head = head->next; // delete head
+        else // we delete Node after prev. Note that both curr and prev are not NULL
+            prev->next = curr->next; // make prev point to Node after curr. This removes curr from list
+        if (curr->next != NULL)
+            curr->next->prev = prev;
+        freeNode(curr);
+    }
+    else if (curr->end - curr->begin < NODE_CAPACITY / 2) // curr is less than half full, so try to merge it with a neighbor
+    {
+        if (prev == NULL || !mergeNext(prev))
+            mergeNext(curr);
+    }
+    return true;
 }
 
-// Deletes every Node to prevent memory leaks.
+// Deletes every Node to prevent memory leaks. Every Node came from pool, so the whole list is freed at once
 // Input: None
 // Output: Void, just deletes every Node of the list
 void LinkedList :: deleteList()
 {
-	Node *curr = head; // curr is the current Node as it progresses through the linked list. Initialized to head to start at the head of the list
-    Node *temp = NULL;
-
-	// curr will loop over list. At every iteration, we first store a pointer to the next Node, and then delete the current Node.
-    while(curr != NULL){ // Looping over list
-		temp = curr->next; // store pointer to next Node in the list
-		delete(curr); // delete the current Node
-		curr = temp; // update curr to proceed through list
-	}
+    pool.release(); // free every Node of the list, without walking it
 	head = NULL;
+    size = 0;
+    index.clear();
     return;
 }
 
@@ -101,9 +324,14 @@ string LinkedList :: print()
 {
     string list_str = ""; // string that has list
 	Node *curr = head; // curr is the current Node as it progresses through the linked list. Initialized to head to start at the head of the list
-	// curr will loop over list. It prints the content of curr, and then moves curr to next Node.
+	// curr will loop over list. It prints the ints of curr, and then moves curr to next Node.
 	while(curr != NULL){ // looping over list
-        list_str = list_str + to_string(curr->data) + " "; //append string with current Node's data
+        for (int i = curr->begin; i < curr->end; i++)
+        {
+            char digits[12]; // enough for any int and its sign
+            list_str.append(digits, to_chars(digits, digits + sizeof(digits), curr->data[i]).ptr); //append string with current int, in place
+            list_str.push_back(' ');
+        }
 		curr = curr->next; // proceed through list
 	}
     if (list_str.length() > 0) // string is non-empty
@@ -111,81 +339,226 @@ string LinkedList :: print()
     return list_str;
 }
 
-// Computes the length of the linked list
+// Prints list in order, straight to a writer instead of through a string
+// Input: writer, where the ints are written, separated by spaces (no newline is written)
+// Output: None
+void LinkedList :: print(Writer& writer)
+{
+    bool first = true; // whether no int has been written yet
+	for (Node *curr = head; curr != NULL; curr = curr->next) // looping over list
+    {
+        for (int i = curr->begin; i < curr->end; i++)
+        {
+            if (!first)
+                writer.write(' ');
+            writer.writeInt(curr->data[i]);
+            first = false;
+        }
+	}
+}
+
+// Prints list in order to a stream, through a Writer
+// Input: out, where the ints are written, separated by spaces (no newline is written)
+// Output: None
+void LinkedList :: print(ostream& out)
+{
+    Writer writer(out);
+    print(writer);
+}
+
+// Returns the length of the linked list. The length is kept in size by insert, deleteNode and deleteList, so no traversal is needed.
 // Input: None
 // Output: Int, length of list
 int LinkedList :: length()
 {
-    int length = 0; // initialize length to zero
-	Node *curr = head; // curr is ths current Node as it progresses through the linked list. Initialized to head to start at the head of the list
-	
-	while(curr != NULL){ // looping over list
-		length++; // increment length
-		curr = curr->next; // proceed to next Node
-	}
-	return length;
+	return size;
 }
 
-// Reverse the linkedlist starting from start
+// Reverse the linkedlist starting from start. The order of the Nodes is reversed, and so is the order of the ints inside every Node.
+// This is done in a single loop rather than by recursion, so long lists cannot overflow the stack.
+// The Nodes keep the same set of labels, mirrored so that they increase along the reversed list, so only the index entries
+// of the values in the reversed Nodes change.
 // Input: Node, the node at which to begin the reversal process
 // Output: Node, the head of the reversed list
 Node* LinkedList :: reverseList(Node* start)
 {
-    if (start == NULL || start->next == NULL) { // base case: the list is empty or the next element is NULL
-        return start;
-    }
+    Node* reversed = NULL; // head of the part of the list that has been reversed so far
+    Node* curr = start; // first Node of the part that has not been reversed yet
 
-    Node* new_head = reverseList(start->next); // recursive call to find the head of the reversed list
-    
-    start->next->next = start; // set the new head's next node to point to the original head
-
-    start->next = NULL; // set the original head's next node to NULL (effectively turns into the tail)
-
-    return new_head;
+    while (curr != NULL) { // looping over list, moving curr to the front of the reversed part
+        std::reverse(curr->data + curr->begin, curr->data + curr->end); // reverse the ints inside curr
+        Node* next = curr->next; // save the rest of the list
+        curr->next = reversed; // make curr point back to the reversed part
+        curr->prev = next;
+        reversed = curr; // curr is the new head of the reversed part
+        curr = next; // proceed through list
+    }
+    if (reversed != NULL) {
+        reversed->prev = NULL;
+        long long labelSum = start->label + reversed->label; // mirror every label inside the range of the old labels
+        for (curr = reversed; curr != NULL; curr = curr->next)
+            curr->label = labelSum - curr->label;
+        indexReversed(reversed);
+    }
+    return reversed;
 }
 
-// Reverses the first val nodes in the linked list
-// Input: Int, the number of nodes from the start of the list to reverse
+// Reverses the first val ints in the linked list. Only the Nodes holding those ints are visited, so this takes O(val) time.
+// Input: Int, the number of ints from the start of the list to reverse
 // Output: None
 void LinkedList :: reverse(int val)
 {
-    if (val < 2) { // check to see that there are at least 2 nodes being reversed
+    if (val < 2) { // check to see that there are at least 2 ints being reversed
         return;
     }
-    else if (val >= length()) { // reverse the entire list if val is greater than or equal to the length of the linked list
+    else if (val >= size) { // reverse the entire list if val is greater than or equal to the length of the linked list
         head = reverseList(head); // set the new head to be the head of the reversed list
         return;
     }
 
-    int counter = 0; // initialize counter to zero to track current place in the linked list.
+    int counter = 0; // number of ints before curr, to track current place in the linked list.
     Node *curr = head; // curr is the current Node as it progresses through the linked list. Initialized to head to start at the head of the list.
-    
-    while (curr != NULL) { // looping over list
-        counter++; // increment counter
-        if (counter < val) { // determine if curr is pointing to the last node of the first val nodes
-            curr = curr->next; // proceed to the next Node;
-        } else {
-            Node* tempHead = head; // save the original head
-            Node* tempList = curr->next; // save the end portion of the original list
-            head = curr;
-            head->next = NULL;
-            head = tempHead;
-            // head = curr; set the current node (the last node of the first val nodes) to be the head
-            // curr->next = NULL;  detach the first val nodes from the linked list
-            // head = tempHead; restore the original head
-            Node* new_head = reverseList(head); // reverse the detached list
-            head->next = tempList; // the original head is now the tail of the detached list, so reconnect the detached list to the original linked list
-            head = new_head; // set the new head of the linked list
-
-            return;
+
+    while (counter + (curr->end - curr->begin) < val) { // looping over list, until curr holds the last of the first val ints
+        counter += curr->end - curr->begin;
+        curr = curr->next; // proceed to the next Node;
+    }
+
+    Node* tempList = curr->next; // save the end portion of the original list
+    int cut = curr->begin + (val - counter); // index in curr->data just past the last of the first val ints
+    if (cut < curr->end) { // curr also holds ints after the first val, so split them off into a Node of their own
+        Node *rest = newNode();
+        rest->begin = cut;
+        rest->end = curr->end;
+        memcpy(rest->data + cut, curr->data + cut, (curr->end - cut) * sizeof(int));
+        rest->next = tempList;
+        rest->prev = curr;
+        curr->next = rest;
+        if (tempList != NULL)
+            tempList->prev = rest;
+        tempList = rest;
+        curr->end = cut;
+
+        // rest needs a label between the labels of curr and the Node after it
+        if (rest->next == NULL)
+            rest->label = curr->label + LABEL_GAP;
+        else if (rest->next->label - curr->label >= 2)
+            rest->label = curr->label + (rest->next->label - curr->label) / 2;
+        else
+            relabel();
+        for (int i = cut; i < rest->end; i++) // the ints after the first val are now held by rest, which has its label
+            indexMove(rest->data[i], curr, rest);
+    }
+    curr->next = NULL; // detach the first val ints from the linked list
+
+    Node* tail = head; // the original head will be the tail of the detached list
+    head = reverseList(head); // reverse the detached list, and set the new head of the linked list
+    tail->next = tempList; // reconnect the detached list to the original linked list
+    tempList->prev = tail;
+    mergeNext(tail); // merge the old head Node, now the last of the reversed part, with the first Node after it, if they fit
+}
+
+// Reverses every consecutive group of k ints in the linked list, in a single pass. For example, with k = 2 the list
+// 10 20 30 40 50 becomes 20 10 40 30 50. If the length is not a multiple of k, the last group is shorter than k and keeps its order.
+// The ints are swapped in place from both ends of each group, so the Nodes themselves are not changed.
+// Input: Int, the number of ints in each group
+// Output: None
+void LinkedList :: reverseGroups(int k)
+{
+    if (k < 2) { // check to see that there are at least 2 ints in a group
+        return;
+    }
+
+    vector<Node*> nodes; // the Nodes that hold the current group, so the group can also be walked backwards
+    Node *groupNode = head; // Node holding the first int of the current group
+    int groupIndex = (head != NULL) ? head->begin : 0; // index of the first int of the current group in groupNode->data
+
+    for (int remaining = size; remaining >= k; remaining -= k) { // looping over the full groups of the list
+        // find the Nodes of the group, and the index of its last int in the last of them
+        nodes.clear();
+        nodes.push_back(groupNode);
+        Node *curr = groupNode;
+        int index = groupIndex;
+        int left = k; // ints of the group that are in curr or after it
+        while (curr->end - index < left) { // the group continues past curr
+            left -= curr->end - index;
+            curr = curr->next; // proceed to the next Node
+            index = curr->begin;
+            nodes.push_back(curr);
+        }
+        int lastIndex = index + left - 1;
+
+        // swap the ints of the group, walking forward from the first int and backward from the last int
+        size_t front = 0, back = nodes.size() - 1;
+        int frontIndex = groupIndex, backIndex = lastIndex;
+        for (int swapped = 0; swapped < k / 2; swapped++) {
+            if (frontIndex == nodes[front]->end) { // move to the next Node of the group
+                front++;
+                frontIndex = nodes[front]->begin;
+            }
+            if (backIndex < nodes[back]->begin) { // move to the previous Node of the group
+                back--;
+                backIndex = nodes[back]->end - 1;
+            }
+            int frontVal = nodes[front]->data[frontIndex];
+            int backVal = nodes[back]->data[backIndex];
+            nodes[front]->data[frontIndex] = backVal;
+            nodes[back]->data[backIndex] = frontVal;
+            if (frontVal != backVal) { // the two values changed Nodes
+                indexMove(frontVal, nodes[front], nodes[back]);
+                indexMove(backVal, nodes[back], nodes[front]);
+            }
+            frontIndex++;
+            backIndex--;
+        }
+
+        // the next group starts right after the last int of this one
+        groupNode = curr;
+        groupIndex = lastIndex + 1;
+        if (groupIndex == curr->end && curr->next != NULL) {
+            groupNode = curr->next;
+            groupIndex = groupNode->begin;
         }
     }
 }
 
 // Determines if the linked list is a palindrome
 // Input: Node, starting location to begin the recursive process of traversing through the list
-// Output: Bool, whether or not the linked list is a palindrome
+// Output: Bool, whether or not the linked list from start is a palindrome
 bool LinkedList :: isPalindrome(Node* start)
 {
-     
-}
\ No newline at end of file
+    vector<Node*> nodes; // the Nodes from start, so the list can also be walked backwards
+    int total = 0;
+    for (Node *curr = start; curr != NULL; curr = curr->next)
+    {
+        nodes.push_back(curr);
+        total += curr->end - curr->begin;
+    }
+
+    // walk forward from the first int and backward from the last int, comparing as we go
+    size_t front = 0, back = nodes.size() - 1;
+    int frontIndex = 0, backIndex = 0;
+    if (total > 0)
+    {
+        frontIndex = nodes[front]->begin;
+        backIndex = nodes[back]->end - 1;
+    }
+    for (int compared = 0; compared < total / 2; compared++)
+    {
+        while (frontIndex == nodes[front]->end) // move to the next Node with ints
+        {
+            front++;
+            frontIndex = nodes[front]->begin;
+        }
+        while (backIndex < nodes[back]->begin) // move to the previous Node with ints
+        {
+            back--;
+            backIndex = nodes[back]->end - 1;
+        }
+        if (nodes[front]->data[frontIndex] != nodes[back]->data[backIndex])
+            return false;
+        frontIndex++;
+        backIndex--;
+    }
+    return true;
+}
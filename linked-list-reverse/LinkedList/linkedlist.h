@@ -1,39 +1,84 @@
 // Filename: linkedlist.h
-// 
+//
 // Header file for the class LinkedList that represents a linked list
-// 
+//
+// The list is unrolled: every Node holds up to NODE_CAPACITY ints in a small array, so a traversal reads
+// whole cache lines of data instead of taking a cache miss per element. The Nodes are allocated from a NodePool
+// (see ../../common/nodepool.h), the same allocator that the word lists of bard use.
+//
 // Japheth Frolick, August 2019
 // C. Seshadhri, Jan 2020
 
 #ifndef LIST_H
 #define LIST_H
 
+#include <ostream>
 #include <string>
+#include <unordered_map>
+#include <vector>
+#include "nodepool.h"
 
 using namespace std;
 
-// node struct to hold data
+class Writer;
+
+const int NODE_CAPACITY = 64; // number of ints one Node can hold
+const long long LABEL_GAP = 1LL << 20; // distance between the labels of neighboring Nodes when labels are (re)assigned
+
+// node struct to hold data. The ints of the Node, in list order, are data[begin], ..., data[end-1].
+// Free slots are kept at the front where possible, so inserting at the head of the list rarely needs a new Node.
+// Labels increase along the list, so comparing labels tells which of two Nodes comes first.
 struct Node
 {
-	int data;
+	int begin; // index in data of the first int of this Node
+	int end; // one past the index in data of the last int of this Node
 	Node *next;
+	Node *prev;
+	long long label; // position of this Node in the list, relative to the other labels
+	int data[NODE_CAPACITY];
+};
+
+// index entry of one value: how many copies of it every Node holds, and the first of those Nodes. first is only
+// trusted while firstEpoch is the labelEpoch of the list; once relabel() runs it is found again from the counts.
+struct IndexEntry
+{
+	unordered_map<Node*, int> counts; // number of copies of the value in each Node holding it
+	Node *first = NULL; // the Node holding the value that comes first in the list, or NULL if it has to be found again
+	long long firstEpoch = 0; // labelEpoch of the list when first was found
 };
 
 class LinkedList
 {
 	private:
 		Node *head; // Stores head of linked list
+        NodePool pool; // Allocates the Nodes of the list, and frees them all at once in deleteList
+        int size; // Number of ints in the list, kept up to date by every operation
+        bool indexed; // whether index is being kept up to date
+        unordered_map<int, IndexEntry> index; // maps every value to the Nodes holding it, with a count per Node
+        long long labelEpoch; // incremented by relabel(), which makes every cached first stale
+        Node* newNode(); // take an uninitialized Node from the pool
+        void freeNode(Node*); // give a Node back to the pool
+        bool mergeNext(Node*); // move the ints of the following Node into this one, if they fit
+        void relabel(); // give every Node a fresh label, LABEL_GAP apart
+        void indexMove(int, Node*, Node*); // record that one copy of int moved from the first Node to the second
+        void indexRemove(int, Node*); // record that one copy of int was removed from the Node
+        Node* indexFirstAfter(IndexEntry&, Node*); // the Node that comes first for a value, after the given first Node lost its last copy
+        void indexReversed(Node*); // recompute the first Node of every value held by the reversed Nodes from the given head
 	public:
 		LinkedList(); // Default constructor sets head to null
-        void insert(int); // insert int into list 
-        Node* find(int); // find int in list, and return pointer to node with that int. If there are multiple copies, this only finds one copy
-        Node* deleteNode(int); // remove a node with int (if it exists), and return pointer to deleted node. This does not delete all nodes with the value.
+        void buildIndex(); // index the values of the list, and keep the index up to date from now on, so find and deleteNode take O(1) expected time
+        void insert(int); // insert int into list
+        Node* find(int); // find int in list, and return pointer to node holding that int. If there are multiple copies, this only finds one copy
+        bool deleteNode(int); // remove an int (if it exists) from the list, and return whether it was removed. This does not delete all copies of the value.
 		void deleteList(); // deletes every node to prevent memory leaks, and frees memory
-		string print(); // Construct string with data of list in order 
-		int length(); // Returns the length of the linked list
+		string print(); // Construct string with data of list in order
+        void print(Writer&); // Write the data of list in order to the writer
+        void print(ostream&); // Write the data of list in order to the stream
+		int length(); // Returns the length of the linked list, in constant time
 
         // Advanced functions follow
-        void reverse(int); // reverse every segment of int entries
+        void reverse(int); // reverse the first int entries
+        void reverseGroups(int); // reverse every consecutive segment of int entries
         Node* reverseList(Node* start); // reverse the linked list from start
         bool isPalindrome(Node* start); // determine if the linked list is a palindrome
 };
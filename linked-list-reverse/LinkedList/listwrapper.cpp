@@ -3,15 +3,19 @@
 // This is the main wrapper for the LinkedList class.
 // 
 // After running make, the usage is:
-//     ./listwrapper <INPUT_FILE> <OUTPUT_FILE>
+//     ./listwrapper [--index] <INPUT_FILE> <OUTPUT_FILE>
+//
+// With --index, the list keeps a hash index from values to nodes, so delete operations do not scan the list.
 // 
-// The input file contains a list of operations performed on a linked list. The operations are insert, delete, and print. 
-// Each line is of the form "i <INT>", "d <INT>", or "p". This means "insert", "delete", and "print" respectively. The second INT argument is for inserting/deleting that number.
+// The input file contains a list of operations performed on a linked list. The operations are insert, delete, print, reverse and group reverse.
+// Each line is of the form "i <INT>", "d <INT>", "p", "rev <INT>" or "revk <INT>". This means "insert", "delete", "print", "reverse" and "group reverse" respectively.
+// The second INT argument is for inserting/deleting that number, or for the number of elements (in every group) to reverse.
 // 
 // Only the print operations generate output, which is the list printed in order in a single line.
 // The output file contains the output of all print commands.
 // 
 // In addition, the console output shows the operations performed, and also prints the list (for every print command).
+// The console output is buffered through trace.h, and is left out of the program entirely by "make TRACEFLAGS=-DNTRACE".
 // Look at the associated pdf in this directory for more details.
 // 
 // Japheth Frolick, August 2019
@@ -26,67 +30,76 @@
 #include <vector> 
 #include <algorithm>
 #include <sstream>
-#include <cstring>
+#include <string_view>
+#include "commands.h"
+#include "writer.h"
+#include "trace.h"
 using namespace std;
 
-
 int main(int argc, char** argv)
 {
+    bool useIndex = false; // whether to index the values of the list
+    if (argc > 1 && string_view(argv[1]) == "--index") // option comes before the files
+    {
+        useIndex = true;
+        argc--;
+        argv++;
+    }
     if (argc < 3) // must provide two arguments as input
     {
-        throw std::invalid_argument("Usage: ./hello <INPUT FILE> <OUTPUT FILE>"); // throw error
+        throw std::invalid_argument("Usage: ./listwrapper [--index] <INPUT FILE> <OUTPUT FILE>"); // throw error
     }
 
-    ifstream input; // stream for input file
+    CommandReader commands; // decodes the input file a block at a time
     ofstream output; // stream for output file
 
-    input.open(argv[1]); // open input file
+    if (!commands.open(argv[1])) // open input file
+    {
+        throw std::runtime_error("Could not open " + string(argv[1])); // throw error
+    }
     output.open(argv[2]); // open output file
+    Writer outputWriter(output); // printed lists are written to the output file in large blocks
 
-    string command; // to store the next command and operation
-    char *com, *dummy, *valstr, *op; // for using with strtok, strtol
-    int val; // the value from the command
+    vector<Command> batch; // the next commands of the input file
 
     LinkedList myList; // initializing the linked list
+    if (useIndex)
+        myList.buildIndex();
         
-
-    while(getline(input,command)) // get next line of input, store as repeat
+    while(commands.nextBatch(batch)) // get next commands of input
     {
-        if (command.length() == 0) // command is empty
-            continue;
-        com = strdup(command.c_str()); // annoying, first copy string into a "C-style" string
-        op = strtok(com, " \t"); //tokenize command on whitespace, first token is operation
-
-        // We first check if command is to print, since we do not need further parsing of command
-        if(strcmp(op,"p") == 0) // print list
+        for (const Command& command : batch) // apply the batch in order
         {
-            output << myList.print() << endl; // write printed list to file, and add new line
-            cout << "Printing" << endl;
-            cout << myList.print() << endl; // printing to console
-            continue; // move on to next command
+            int val = command.value; // the value from the command
+            switch (command.type)
+            {
+                case PRINT: // print list
+                    myList.print(outputWriter); // write printed list to file, and add new line
+                    outputWriter.write('\n');
+                    TRACE(TRACE_INFO, "Printing");
+                    TRACE(TRACE_INFO, myList); // printing to console
+                    break;
+                case INSERT: // insert into list
+                    TRACE(TRACE_INFO, "Insert ", val);
+                    myList.insert(val);
+                    break;
+                case DELETE: // delete from list
+                    TRACE(TRACE_INFO, "Delete ", val);
+                    myList.deleteNode(val);
+                    break;
+                case REVERSE: // reverse list
+                    TRACE(TRACE_INFO, "Reverse ", val);
+                    myList.reverse(val);
+                    break;
+                case REVERSE_GROUPS: // reverse every group of val elements
+                    TRACE(TRACE_INFO, "Reverse groups ", val);
+                    myList.reverseGroups(val);
+                    break;
+            }
         }
+    }
 
-        valstr = strtok(NULL, " \t"); // next token is value, as string (check out documentation on strtok, to understand the parsing)
-        if(valstr != NULL) // first check if there is actually anything to convert into int
-            val = strtol(valstr, &dummy, 10); // convert initial portion of valstr into an integer val, with base 10. Check out documentation on strtol for more details. 
-    
-        if(strcmp(op,"i") == 0) // insert into list
-        {
-            cout << "Insert "+to_string(val) << endl;
-            myList.insert(val);
-        }
-        if(strcmp(op,"d") == 0) // delete from list
-        {
-            cout << "Delete "+to_string(val) << endl;
-            myList.deleteNode(val);
-        }
-        if(strcmp(op,"rev") == 0) // reverse list
-        {
-            cout << "Reverse "+to_string(val) << endl;
-            myList.reverse(val);
-        }
-     }
-
-     input.close();
+     outputWriter.flush(); // write whatever is left before the output file is closed
+     traceFlush(); // and whatever is left of the console messages
      output.close();
 }